@@ -0,0 +1,335 @@
+/**************************************************************************************************
+bench.c
+Micro-benchmarks
+
+A benchmark case is a function doing one iteration of the work to time, plus an optional setup
+function.  Modules register NULL terminated tables of cases with bench_register(), the same way
+they register commands; this file has the parsing, dispatch, memcpy() and CRC cases, logger.c
+the logging and log ring cases.
+
+"bench [case] [iterations]" runs every case whose name starts with "case" ("all" for every case,
+"list" to list them): setup, BENCH_WARMUP untimed iterations, then the timed iterations.  Each
+iteration is timed on its own with the DWT cycle counter (CPU clock cycles), less the cost of
+calling an empty case.  TC0 times the whole run as the wall clock.  Interrupts stay enabled, so
+the p99 and max columns include whatever interrupt handlers ran meanwhile; min and median are the
+cost of the code itself.  log_msg() output from a case is captured into a scratch buffer and
+thrown away, and the results are printed once every case has run, so the console transmitter
+isn't busy while timing.
+
+The results are one line per case, whitespace separated, after a header line starting with '#':
+    # case           n      min   median      p99      max  wall_us
+    parse_int      100       61       61       64      198       14
+The host simulation (tools/sim) runs the same cases, with cycles scaled from the host clock.
+
+**************************************************************************************************/
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "definitions.h"                // SYS function prototypes
+#include "command_line.h"
+#include "logger.h"
+#include "parse.h"
+#include "crc.h"
+
+#define BENCH_WARMUP        8U          // untimed iterations before the timed ones
+#define BENCH_ITERATIONS    "100"
+#define BENCH_OUTPUT_SIZE   128U        // captured log_msg() output of one iteration
+#define BENCH_COPY_SIZE     1024U       // memcpy() case
+#define BENCH_CRC_SIZE      256U        // CRC cases
+#define BENCH_INDEX_MAX     500U        // largest synthetic command table
+#define BENCH_INDEX_LOOKUPS 100U        // lookups per iteration of the index and scan cases
+
+typedef struct {
+    const char *    name;
+    uint32_t        min;                // cycles
+    uint32_t        median;
+    uint32_t        p99;
+    uint32_t        max;
+    uint32_t        wall_us;            // TC0 time for all the timed iterations
+} BENCH_RESULT;
+
+static const BENCH_CASE * bench_tables[BENCH_MAX_TABLES];
+static int bench_table_count;
+
+static uint32_t samples[BENCH_MAX_SAMPLES];
+static BENCH_RESULT results[BENCH_MAX_CASES];
+static char bench_output[BENCH_OUTPUT_SIZE];
+
+static int cl_bench(CL_CONTEXT *ctx);
+
+static const CL_ARG bench_args[] = {
+    {"case",       CL_ARG_STR,     0, 0,                 "all"},
+    {"iterations", CL_ARG_INT,     1, BENCH_MAX_SAMPLES, BENCH_ITERATIONS},
+    {NULL},
+};
+
+static const COMMAND_ITEM bench_cmd_table[] = {
+    {"bench",     "micro-benchmarks, \"bench [list|all|<case>] [iterations]\"", cl_bench, bench_args},
+    {NULL,NULL,NULL}, /* end of table */
+};
+
+//=================================================================================================
+// Cases
+//=================================================================================================
+static uint32_t copy_src[BENCH_COPY_SIZE / 4];
+static uint32_t copy_dst[BENCH_COPY_SIZE / 4];
+static CL_CONTEXT bench_ctx;
+static volatile uint32_t bench_sink;   // results go here, so the work isn't optimized away
+
+static void bench_parse_int(void) {
+    int32_t value;
+    parse_int("-1234567", &value);
+    bench_sink = (uint32_t)value;
+}
+
+static void bench_parse_hex(void) {
+    int32_t value;
+    parse_int("0xDEADBEEF", &value);
+    bench_sink = (uint32_t)value;
+}
+
+static void bench_parse_float(void) {
+    float value;
+    parse_float("-3.14159e2", &value);
+    bench_sink = (uint32_t)value;
+}
+
+// Split a line into words, as the command line does before each command
+static void bench_split(void) {
+    char line[MAXSERIALBUF];
+    char *words[MAXWORDS];
+    strcpy(line, "crc 0x00000000 4096 \"two words\"");
+    bench_sink = (uint32_t)cl_parseArgcArgv(line, words, MAXWORDS);
+}
+
+static void bench_lookup(void) {
+    bench_sink = (uint32_t)(uintptr_t)cl_find_command("version");
+}
+
+static void bench_lookup_prefix(void) {
+    bench_sink = (uint32_t)(uintptr_t)cl_find_command_prefix("vers");
+}
+
+// Dispatch scaling: a synthetic command table of index_size entries with made up names, sorted
+// into an index the way cl_register() does.  Each iteration looks up the next BENCH_INDEX_LOOKUPS
+// names in turn, with cl_index_find() or with the linear strcmp() scan the index replaced, so the
+// cycles divided by 100 are the cost of one lookup.
+static COMMAND_ITEM index_items[BENCH_INDEX_MAX + 1U];
+static const COMMAND_ITEM * index_sorted[BENCH_INDEX_MAX];
+static char index_names[BENCH_INDEX_MAX][8];
+static uint32_t index_size;
+static uint32_t index_next;
+
+static int bench_index_compare(const void *a, const void *b) {
+    return strcmp((*(const COMMAND_ITEM * const *)a)->command, (*(const COMMAND_ITEM * const *)b)->command);
+}
+
+static void bench_index_build(uint32_t size) {
+    uint32_t seed = 0x12345678U;
+    for (uint32_t i = 0; i < size; i++) {
+        char *name = index_names[i];
+        for (int c = 0; c < 4; c++) {          // four pseudo random letters, then the entry number
+            seed = seed * 1664525U + 1013904223U;
+            name[c] = (char)('a' + (seed >> 24) % 26U);
+        }
+        name[4] = (char)('0' + i / 100U);
+        name[5] = (char)('0' + (i / 10U) % 10U);
+        name[6] = (char)('0' + i % 10U);
+        name[7] = '\0';
+        index_items[i].command = name;
+        index_sorted[i] = &index_items[i];
+    }
+    index_items[size].command = NULL;
+    qsort(index_sorted, size, sizeof(index_sorted[0]), bench_index_compare);
+    index_size = size;
+    index_next = 0;
+}
+
+static void bench_index_10(void)  { bench_index_build(10U); }
+static void bench_index_50(void)  { bench_index_build(50U); }
+static void bench_index_100(void) { bench_index_build(100U); }
+static void bench_index_500(void) { bench_index_build(BENCH_INDEX_MAX); }
+
+static const char * bench_index_key(void) {
+    const char *name = index_items[index_next].command;
+    if (++index_next == index_size) index_next = 0;
+    return name;
+}
+
+static void bench_index_find(void) {
+    for (uint32_t i = 0; i < BENCH_INDEX_LOOKUPS; i++) {
+        bench_sink = (uint32_t)(uintptr_t)cl_index_find(index_sorted, (int)index_size, bench_index_key());
+    }
+}
+
+static void bench_index_scan(void) {
+    for (uint32_t i = 0; i < BENCH_INDEX_LOOKUPS; i++) {
+        const char *name = bench_index_key();
+        const COMMAND_ITEM *cmd = index_items;
+        while (cmd->command && strcmp(name, cmd->command) != 0) cmd++;
+        bench_sink = (uint32_t)(uintptr_t)cmd;
+    }
+}
+
+static void bench_dispatch_setup(void) {
+    cl_context_init(&bench_ctx, NULL, 0);
+}
+
+// A whole command: split, lookup, argument conversion and the "add" handler, output captured
+static void bench_dispatch(void) {
+    strcpy(bench_ctx.buffer, "add 0x10 -20");
+    cl_process_buffer(&bench_ctx);
+}
+
+static void bench_copy_setup(void) {
+    for (uint32_t i = 0; i < BENCH_COPY_SIZE / 4; i++) {
+        copy_src[i] = i * 0x9E3779B9U;
+    }
+}
+
+static void bench_memcpy(void) {
+    memcpy(copy_dst, copy_src, BENCH_COPY_SIZE);
+}
+
+static void bench_crc32(void) {
+    bench_sink = crc32(copy_src, BENCH_CRC_SIZE);
+}
+
+static void bench_crc32_sw(void) {
+    bench_sink = crc32_sw(copy_src, BENCH_CRC_SIZE);
+}
+
+static const BENCH_CASE bench_table[] = {
+    {"parse_int",   "parse_int() of a 7 digit decimal",             NULL,                   bench_parse_int},
+    {"parse_hex",   "parse_int() of an 8 digit hex value",          NULL,                   bench_parse_hex},
+    {"parse_float", "parse_float() with a fraction and exponent",   NULL,                   bench_parse_float},
+    {"split",       "cl_parseArgcArgv() of a 4 word line",          NULL,                   bench_split},
+    {"lookup",      "cl_find_command(), exact name",                NULL,                   bench_lookup},
+    {"lookup_pre",  "cl_find_command_prefix(), unique prefix",      NULL,                   bench_lookup_prefix},
+    {"dispatch",    "cl_process_buffer() of \"add 0x10 -20\"",      bench_dispatch_setup,   bench_dispatch},
+    {"index_10",    "100 cl_index_find(), 10 command table",        bench_index_10,         bench_index_find},
+    {"index_50",    "100 cl_index_find(), 50 command table",        bench_index_50,         bench_index_find},
+    {"index_100",   "100 cl_index_find(), 100 command table",       bench_index_100,        bench_index_find},
+    {"index_500",   "100 cl_index_find(), 500 command table",       bench_index_500,        bench_index_find},
+    {"scan_10",     "100 strcmp() scans, 10 command table",         bench_index_10,         bench_index_scan},
+    {"scan_50",     "100 strcmp() scans, 50 command table",         bench_index_50,         bench_index_scan},
+    {"scan_100",    "100 strcmp() scans, 100 command table",        bench_index_100,        bench_index_scan},
+    {"scan_500",    "100 strcmp() scans, 500 command table",        bench_index_500,        bench_index_scan},
+    {"memcpy",      "memcpy() of 1024 aligned bytes",               bench_copy_setup,       bench_memcpy},
+    {"crc32",       "crc32() of 256 bytes, DSU on the target",      bench_copy_setup,       bench_crc32},
+    {"crc32_sw",    "crc32_sw() of 256 bytes, table driven",        bench_copy_setup,       bench_crc32_sw},
+    {NULL,NULL,NULL,NULL}, /* end of table */
+};
+
+//=================================================================================================
+// Runner
+//=================================================================================================
+
+// Start the DWT cycle counter (uart.c may have already), register the command and our cases
+void bench_init(void) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    cl_register(bench_cmd_table);
+    bench_register(bench_table);
+}
+
+// Register a NULL terminated table of cases.  Return 0, or -1 if there is no room for it.
+int bench_register(const BENCH_CASE * table) {
+    if (bench_table_count >= BENCH_MAX_TABLES) {
+        log_msg("%s(), no room for \"%s\"\n", __func__, table[0].name);
+        return -1;
+    }
+    bench_tables[bench_table_count++] = table;
+    return 0;
+}
+
+static void bench_nothing(void) {
+}
+
+// Cycles taken by reading CYCCNT around an indirect call of an empty function, the best of a few
+static uint32_t bench_overhead(void) {
+    void (* volatile run)(void) = bench_nothing;
+    uint32_t best = UINT32_MAX;
+    for (int i = 0; i < 16; i++) {
+        uint32_t start = DWT->CYCCNT;
+        run();
+        uint32_t cycles = DWT->CYCCNT - start;
+        if (cycles < best) best = cycles;
+    }
+    return best;
+}
+
+static int bench_compare(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void bench_case(const BENCH_CASE *bc, uint32_t iterations, uint32_t overhead, BENCH_RESULT *result) {
+    if (bc->setup) bc->setup();
+    for (uint32_t i = 0; i < BENCH_WARMUP; i++) {
+        log_capture_start(bench_output, sizeof(bench_output));
+        bc->run();
+        log_capture_stop();
+    }
+
+    uint32_t start_us = TC0_Timer32bitCounterGet();
+    for (uint32_t i = 0; i < iterations; i++) {
+        log_capture_start(bench_output, sizeof(bench_output));
+        uint32_t start = DWT->CYCCNT;
+        bc->run();
+        uint32_t cycles = DWT->CYCCNT - start;
+        log_capture_stop();
+        samples[i] = (cycles > overhead) ? cycles - overhead : 0U;
+    }
+    result->wall_us = TC0_Timer32bitCounterGet() - start_us;
+
+    qsort(samples, iterations, sizeof(samples[0]), bench_compare);
+    result->name = bc->name;
+    result->min = samples[0];
+    result->median = samples[iterations / 2U];
+    result->p99 = samples[(iterations * 99U + 99U) / 100U - 1U];
+    result->max = samples[iterations - 1U];
+}
+
+static int cl_bench(CL_CONTEXT *ctx) {
+    const char *name = ctx->args[0].s;
+    uint32_t iterations = (uint32_t)ctx->args[1].i;
+    bool all = (strcmp(name, "all") == 0);
+    size_t len = strlen(name);
+    uint32_t count = 0;
+
+    if (strcmp(name, "list") == 0) {
+        for (int t = 0; t < bench_table_count; t++) {
+            for (int i = 0; bench_tables[t][i].name; i++) {
+                log_msg("%-12s%s\n", bench_tables[t][i].name, bench_tables[t][i].comment);
+            }
+        }
+        return 0;
+    }
+
+    uint32_t overhead = bench_overhead();
+    for (int t = 0; t < bench_table_count; t++) {
+        for (int i = 0; bench_tables[t][i].name && count < BENCH_MAX_CASES; i++) {
+            if (all || strncmp(bench_tables[t][i].name, name, len) == 0) {
+                bench_case(&bench_tables[t][i], iterations, overhead, &results[count++]);
+            }
+        }
+    }
+    if (count == 0) {
+        log_msg("No benchmark \"%s\", see \"bench list\"\n", name);
+        return -1;
+    }
+
+    log_msg("# cycles at %lu MHz, %lu cycle call overhead removed\n",
+            (uint32_t)(CPU_CLOCK_FREQUENCY / 1000000U), overhead);
+    log_msg("# %-12s %4s %8s %8s %8s %8s %8s\n", "case", "n", "min", "median", "p99", "max", "wall_us");
+    for (uint32_t i = 0; i < count; i++) {
+        const BENCH_RESULT *r = &results[i];
+        log_msg("%-14s %4lu %8lu %8lu %8lu %8lu %8lu\n",
+                r->name, iterations, r->min, r->median, r->p99, r->max, r->wall_us);
+    }
+    return (int)count;
+}
@@ -0,0 +1,23 @@
+// bench.h
+//
+// Micro-benchmark cases timed with the DWT cycle counter, see bench.c
+
+#ifndef BENCH_H
+#define BENCH_H
+#include <stdint.h>
+
+#define BENCH_MAX_TABLES    8   // number of case tables that may be registered
+#define BENCH_MAX_CASES     32  // results kept by one "bench" command
+#define BENCH_MAX_SAMPLES   256 // timed iterations of a case
+
+typedef struct {
+    const char * name;
+    const char * comment;
+    void (*setup)(void);        // called once before the warm-up, NULL if not needed
+    void (*run)(void);          // one iteration, the part that is timed
+} BENCH_CASE;
+
+void bench_init(void);
+int bench_register(const BENCH_CASE * table);
+
+#endif // BENCH_H
@@ -5,8 +5,9 @@
 //
 // Using serial interface, receive commands with parameters.
 // Parse the command and parameters, look up the command in a table, execute the command.
-// Since the command/argument buffer is global with global pointers, each command will parse its own arguments.
-// Since no arguments are passed in the function call, all commands will have int command_name(void) prototype.
+// Each command source (the console, binary RPC, a background job) has its own CL_CONTEXT holding the line,
+// its words (argc/argv), the converted arguments and where the output goes.  All commands have the
+// int command_name(CL_CONTEXT *ctx) prototype, and take their arguments from ctx.
 
 // Notes:
 // The stdio library's stdout stream is buffered by default.  This makes printf() and putchar() work strangely
@@ -16,6 +17,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdint.h>                     // uint8_t
+#include <stdbool.h>
 #include <stdio.h>                      // EOF
 #include "command_line.h"
 
@@ -24,35 +26,142 @@
 #include "sam.h"
 #include "logger.h"     // send output though "logger" module
 #include "version.h"
+#include "rpc.h"
+#include "parse.h"
 
-// Typedefs
-typedef struct {
-  char * command;
-  char * comment;
-  int (*function)(void); // pointer to command function
-} COMMAND_ITEM;
+static const CL_ARG add_args[] = {
+    {"number",    CL_ARG_INT,     INT32_MIN, INT32_MAX, NULL},
+    {"number",    CL_ARG_INT,     INT32_MIN, INT32_MAX, NULL},
+    {NULL},
+};
 
 const COMMAND_ITEM cmd_table[] = {
     {"?",         "display help menu",                                      cl_help},
     {"help",      "display help menu",                                      cl_help},
     {"cls",       "clear screen",                                           cl_cls},
-    {"add",       "add <number> <number>",                                  cl_add},
+    {"add",       "add <number> <number>",                                  cl_add, add_args},
     {"id",        "unique ID",                                              cl_id},
     {"reset",     "reset processor",                                        cl_reset},
     {"info",      "processor info",                                         cl_info},
     {"timer",     "timer test - measure 50ms SYSTICK delay",                cl_timer},
-    {"logger",    "Log message test",                                       cl_logger_test},
     {"version",   "display firmware version",                               cl_version},
+    {"lookup",    "command lookup test - indexed vs linear scan",           cl_lookup_test},
+    {"history",   "list command history, recall with up/down arrow keys",   cl_history},
+    {"script",    "script begin|end - run the following lines as a batch",  cl_script},
     {NULL,NULL,NULL}, /* end of table */
 };
 
-// Globals:
-char buffer[MAXSERIALBUF]; // holds command strings from user
-char * argv[MAXWORDS]; // pointers into buffer
-int argc; // number of words (command & arguments)
+// Command tables registered with cl_register(), in registration order (used by help)
+static const COMMAND_ITEM * cmd_tables[CL_MAX_TABLES];
+static int cmd_table_count;
+
+// Index of all registered command table entries, sorted by command name.  Entries are inserted
+// as each table is registered, then searched with a binary search, so dispatch cost grows with
+// log2(number of commands) rather than with the number of commands.
+static const COMMAND_ITEM * cmd_index[CL_MAX_COMMANDS];
+static int cmd_count;
+
+static void cl_run_command(CL_CONTEXT *ctx, char *command);
+
+// The console (SERCOM5 terminal) session
+static CL_CONTEXT console;
+
+// Register a NULL terminated command table.  Each entry is inserted into cmd_index[], keeping
+// it sorted by command name.  Modules call this at startup to contribute their own commands.
+// Return 0 on success, -1 if the table could not be registered (table/index full, or duplicate name)
+// The failures are a build problem, not a run time one, so they are shown in a red box at startup
+// rather than left to the callers.
+int cl_register(const COMMAND_ITEM * table) {
+    char error[128];
+    int entries = 0;
+    while (table[entries].command) entries++;
+    if (cmd_table_count >= CL_MAX_TABLES || cmd_count + entries > CL_MAX_COMMANDS) {
+        snprintf(error, sizeof(error), "%s(), no room for \"%s\" and %d more commands\n"
+                 "raise CL_MAX_TABLES (%d) or CL_MAX_COMMANDS (%d)", __func__, table[0].command,
+                 entries - 1, CL_MAX_TABLES, CL_MAX_COMMANDS);
+        text_in_box(error, COLOR_YELLOW_ON_RED);
+        return -1;
+    }
+    for (int i = 0; i < entries; i++) {
+        if (cl_find_command(table[i].command)) {
+            snprintf(error, sizeof(error), "%s(), duplicate command \"%s\"", __func__, table[i].command);
+            text_in_box(error, COLOR_YELLOW_ON_RED);
+            return -1;
+        }
+    }
+    for (int i = 0; i < entries; i++) {
+        int j = cmd_count;
+        while (j > 0 && strcmp(cmd_index[j - 1]->command, table[i].command) > 0) {
+            cmd_index[j] = cmd_index[j - 1]; // shift larger names up one slot
+            j--;
+        }
+        cmd_index[j] = &table[i];
+        cmd_count++;
+    }
+    cmd_tables[cmd_table_count++] = table;
+    return 0;
+}
+
+// Find the commands whose names start with the len characters of prefix.  They are adjacent in
+// the sorted index: binary search for the first one, then for the first one past them.  Return
+// the number of matches, and the position of the first match in *first.
+int cl_find_prefix(const char * prefix, int len, int * first) {
+    int lo = 0;
+    int hi = cmd_count;
+    while (lo < hi) {   // first name >= prefix
+        int mid = (lo + hi) / 2;
+        if (strncmp(cmd_index[mid]->command, prefix, len) < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    *first = lo;
+    hi = cmd_count;
+    while (lo < hi) {   // first name past the matches
+        int mid = (lo + hi) / 2;
+        if (strncmp(cmd_index[mid]->command, prefix, len) <= 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo - *first;
+}
+
+// Look up a typed command name: an exact match, or else a unique prefix ("ver" runs "version").
+// Return NULL if there is no match, or more than one.
+const COMMAND_ITEM * cl_find_command_prefix(const char * name) {
+    const COMMAND_ITEM * cmd = cl_find_command(name);
+    int first;
+    if (cmd == NULL && cl_find_prefix(name, strlen(name), &first) == 1) cmd = cmd_index[first];
+    return cmd;
+}
+
+// Return the command at position in name order, or NULL past the end.  rpc.c uses the position
+// as the command ID.
+const COMMAND_ITEM * cl_command_at(int position) {
+    return (position >= 0 && position < cmd_count) ? cmd_index[position] : NULL;
+}
+
+// Binary search a command index sorted by name.  Return matching table entry, or NULL if not found.
+// The "bench" dispatch cases run it over synthetic indexes of different sizes.
+const COMMAND_ITEM * cl_index_find(const COMMAND_ITEM * const * index, int count, const char * name) {
+    int lo = 0;
+    int hi = count - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        int cmp = strcmp(name, index[mid]->command);
+        if (cmp == 0) return index[mid];
+        if (cmp < 0) hi = mid - 1;
+        else lo = mid + 1;
+    }
+    return NULL;
+}
+
+// Look up a command name in the registered commands.  Return matching table entry, or NULL.
+const COMMAND_ITEM * cl_find_command(const char * name) {
+    return cl_index_find(cmd_index, cmd_count, name);
+}
 
 void cl_setup(void) {
     char banner[128];
+    cl_context_init(&console, NULL, 0);
+    cl_register(cmd_table);
     // Print banner with version and date using yellow on blue text
     snprintf(banner,sizeof(banner),"Command Line parser, %s, %s %s\n"
                                    "Enter \"help\" or \"?\" for list of commands",
@@ -62,72 +171,516 @@ void cl_setup(void) {
     log_msg(">"); // initial command line prompt
 }
 
+//=================================================================================================
+// Command history: the last CL_HISTORY_LINES lines, packed one after another into a byte ring
+// (hist_arena).  The oldest lines are dropped when either runs out.  No malloc.
+//=================================================================================================
+static char hist_arena[CL_HISTORY_ARENA];
+static uint16_t hist_offset[CL_HISTORY_LINES];  // arena offset of each line, ring of indexes
+static uint8_t hist_length[CL_HISTORY_LINES];
+static int hist_oldest;                         // index of the oldest line in hist_offset[]
+static int hist_count;
+static uint32_t hist_used;                      // arena bytes in use
+
+// Add a line to the history, unless it is empty or repeats the newest line
+static void cl_history_add(const char *line, int len) {
+    char newest[MAXSERIALBUF];
+    if (len == 0 || len >= CL_HISTORY_ARENA) return;
+    if (hist_count && cl_history_get(0, newest) == len && memcmp(newest, line, len) == 0) return;
+
+    while (hist_count == CL_HISTORY_LINES || hist_used + len > CL_HISTORY_ARENA) {
+        hist_used -= hist_length[hist_oldest];
+        hist_oldest = (hist_oldest + 1) % CL_HISTORY_LINES;
+        hist_count--;
+    }
+    int slot = (hist_oldest + hist_count) % CL_HISTORY_LINES;
+    uint32_t offset = hist_count ? (hist_offset[(slot + CL_HISTORY_LINES - 1) % CL_HISTORY_LINES] +
+                                    hist_length[(slot + CL_HISTORY_LINES - 1) % CL_HISTORY_LINES]) % CL_HISTORY_ARENA : 0;
+    for (int i = 0; i < len; i++) {
+        hist_arena[(offset + i) % CL_HISTORY_ARENA] = line[i];
+    }
+    hist_offset[slot] = (uint16_t)offset;
+    hist_length[slot] = (uint8_t)len;
+    hist_used += len;
+    hist_count++;
+}
+
+// Copy history line n (0 is the newest) into line, not NUL terminated.  Return its length, or -1.
+int cl_history_get(int n, char *line) {
+    if (n < 0 || n >= hist_count) return -1;
+    int slot = (hist_oldest + hist_count - 1 - n) % CL_HISTORY_LINES;
+    for (int i = 0; i < hist_length[slot]; i++) {
+        line[i] = hist_arena[(hist_offset[slot] + i) % CL_HISTORY_ARENA];
+    }
+    return hist_length[slot];
+}
+
+int cl_history(CL_CONTEXT *ctx) {
+    char line[MAXSERIALBUF];
+    for (int n = hist_count - 1; n >= 0; n--) {
+        int len = cl_history_get(n, line);
+        log_msg("%3d  %.*s\n", hist_count - n, len, line);
+    }
+    return 0;
+}
+
+//=================================================================================================
+// Line editor.  VT100 keys: up/down recall history, left/right/home/end move the cursor, delete
+// and backspace remove characters.  Each key echoes only what changed on the screen: typing at
+// the end of the line echoes one character, editing in the middle rewrites only the rest of the
+// line.  Tab completes command names.  Escape sequences are decoded one character at a time by a
+// small state machine.
+//=================================================================================================
+typedef enum {
+    KEY_STATE_NORMAL,
+    KEY_STATE_ESC,          // ESC received
+    KEY_STATE_CSI,          // ESC [ received, parameter digits may follow
+    KEY_STATE_SS3,          // ESC O received (application cursor keys)
+} KEY_STATE;
+
+static int line_len;        // characters in buffer[]
+static int line_pos;        // cursor position, 0 to line_len
+static int hist_pos = -1;   // history line being shown, -1 for the line being typed
+static char draft[MAXSERIALBUF];    // the line being typed, while browsing history
+static int draft_len;
+
+// Echo collected for one key, sent with a single write
+static char echo_buf[3 * MAXSERIALBUF];
+static int echo_len;
+
+static void echo_chars(const char *p, int n) {
+    if (n > (int)sizeof(echo_buf) - echo_len) n = sizeof(echo_buf) - echo_len;
+    memcpy(&echo_buf[echo_len], p, n);
+    echo_len += n;
+}
+
+static void echo_repeat(char c, int n) {
+    while (n-- > 0 && echo_len < (int)sizeof(echo_buf)) echo_buf[echo_len++] = c;
+}
+
+// Move the terminal cursor n columns left, with backspaces or ESC[nD, whichever is shorter
+static void echo_left(int n) {
+    if (n <= 3) {
+        echo_repeat(_BS, n);
+    } else {
+        echo_len += snprintf(&echo_buf[echo_len], sizeof(echo_buf) - echo_len, "\x1B[%dD", n);
+    }
+}
+
+static void echo_flush(void) {
+    if (echo_len) log_bytes(echo_buf, echo_len);
+    echo_len = 0;
+}
+
+// Rewrite the screen from the cursor on after buffer[] changed there.  old_len is the line
+// length the screen shows.  The cursor is left at line_pos.
+static void echo_tail(int old_len) {
+    echo_chars(&console.buffer[line_pos], line_len - line_pos);
+    echo_repeat(' ', old_len - line_len);   // blank out characters that went away
+    echo_left((old_len > line_len ? old_len : line_len) - line_pos);
+}
+
+// Show a different line (history recall).  Only the part after the common prefix is rewritten.
+static void line_replace(const char *text, int len) {
+    int same = 0;
+    while (same < len && same < line_len && console.buffer[same] == text[same]) same++;
+    if (line_pos > same) {
+        echo_left(line_pos - same);
+    } else {
+        echo_chars(&console.buffer[line_pos], same - line_pos);
+    }
+    echo_chars(&text[same], len - same);
+    if (line_len > len) {
+        echo_repeat(' ', line_len - len);   // blank out the rest of the longer old line
+        echo_left(line_len - len);
+    }
+    memcpy(console.buffer, text, len);
+    line_len = len;
+    line_pos = len;
+}
+
+static void key_history(int direction) {
+    char line[MAXSERIALBUF];
+    int n = hist_pos + direction;
+    if (n < -1 || n >= hist_count) return;
+    if (hist_pos == -1) {
+        memcpy(draft, console.buffer, line_len);
+        draft_len = line_len;
+    }
+    hist_pos = n;
+    if (n == -1) {
+        line_replace(draft, draft_len);
+    } else {
+        int len = cl_history_get(n, line);
+        line_replace(line, len);
+    }
+}
+
+static void key_insert(char c) {
+    if (line_len >= MAXSERIALBUF - 1) return;
+    memmove(&console.buffer[line_pos + 1], &console.buffer[line_pos], line_len - line_pos);
+    console.buffer[line_pos] = c;
+    line_len++;
+    echo_chars(&c, 1);
+    line_pos++;
+    echo_tail(line_len);
+}
+
+// Remove the character at the cursor
+static void key_delete(void) {
+    if (line_pos == line_len) return;
+    memmove(&console.buffer[line_pos], &console.buffer[line_pos + 1], line_len - line_pos - 1);
+    line_len--;
+    echo_tail(line_len + 1);
+}
+
+static void key_backspace(void) {
+    if (line_pos == 0) return;
+    line_pos--;
+    echo_left(1);
+    key_delete();
+}
+
+static void key_cursor(int pos) {
+    if (pos < 0 || pos > line_len) return;
+    if (pos < line_pos) {
+        echo_left(line_pos - pos);
+    } else {
+        echo_chars(&console.buffer[line_pos], pos - line_pos);  // retype to move right
+    }
+    line_pos = pos;
+}
+
+// Tab completes the command name (the first word) when the cursor is at its end.  A unique match
+// is completed with a space after it.  Otherwise the common part of the matching names is filled
+// in, and if there is none, the matches are listed and the line is shown again.
+static void key_tab(void) {
+    int first;
+    int matches;
+
+    if (line_pos != line_len || memchr(console.buffer, ' ', line_len) != NULL) return;
+    matches = cl_find_prefix(console.buffer, line_len, &first);
+    if (matches == 0) {
+        echo_chars("\a", 1);   // bell
+        return;
+    }
+
+    const char *name = cmd_index[first]->command;
+    const char *last = cmd_index[first + matches - 1]->command;
+    int common = line_len;      // the first and last names share the longest prefix of the range
+    while (name[common] && name[common] == last[common]) common++;
+    if (matches == 1 || common > line_len) {
+        while (line_len < common && line_len < MAXSERIALBUF - 1) key_insert(name[line_len]);
+        if (matches == 1) key_insert(' ');
+        return;
+    }
+
+    echo_flush();
+    log_msg("\n");
+    for (int i = first; i < first + matches; i++) {
+        log_msg("%-12s%s", cmd_index[i]->command, ((i - first) % 6 == 5) ? "\n" : "");
+    }
+    log_msg("\n>%.*s", line_len, console.buffer);
+}
+
+//=================================================================================================
+// Script mode.  After "script begin", pasted lines are collected and run straight from the RX
+// ring without echo, line editing or a prompt, and cl_loop() keeps going until the ring is empty
+// instead of returning after each line.  "script end" reports the lines, commands and errors
+// and the time since "script begin".  Lines too long for buffer[] are skipped and counted.
+//=================================================================================================
+static bool script_active;
+static bool script_overflow;        // the current line didn't fit in buffer[]
+static uint32_t script_start_us;
+static uint32_t script_lines;
+static uint32_t script_skipped;
+static uint32_t script_commands;    // commands_run, commands_unknown and commands_failed when
+static uint32_t script_unknown;     // the script began
+static uint32_t script_failed;
+
+// Commands run by cl_process_buffer(), commands not found or ambiguous, and commands whose
+// arguments didn't match their schema
+static uint32_t commands_run;
+static uint32_t commands_unknown;
+static uint32_t commands_failed;
+
+// One character of a script line
+static void script_char(char c) {
+    if (c == _CR || c == _LF) {
+        if (script_overflow) {
+            script_skipped++;
+            log_msg("Script line %lu too long, skipped\n", script_lines + script_skipped);
+        } else if (line_len) {
+            console.buffer[line_len] = 0;
+            script_lines++;
+            cl_process_buffer(&console);
+            if (!script_active) log_msg("\n>"); // "script end"
+        }
+        line_len = 0;
+        script_overflow = false;
+    } else if (line_len < MAXSERIALBUF - 1) {
+        console.buffer[line_len++] = c;
+    } else {
+        script_overflow = true;
+    }
+}
+
+int cl_script(CL_CONTEXT *ctx) {
+    if (ctx != &console) {
+        log_msg("Script mode is for the console\n");
+        return 1;
+    }
+    if (ctx->argc > 1 && strcmp(ctx->argv[1], "begin") == 0) {
+        log_msg("Script mode, end with \"script end\"\n");
+        script_active = true;
+        script_overflow = false;
+        script_lines = 0;
+        script_skipped = 0;
+        script_commands = commands_run;
+        script_unknown = commands_unknown;
+        script_failed = commands_failed;
+        script_start_us = TC0_Timer32bitCounterGet();
+    } else if (ctx->argc > 1 && strcmp(ctx->argv[1], "end") == 0) {
+        if (!script_active) {
+            log_msg("No script running\n");
+            return 0;
+        }
+        uint32_t elapsed_us = TC0_Timer32bitCounterGet() - script_start_us;
+        script_active = false;
+        log_msg("Script: %lu lines, %lu commands, %lu not found, %lu failed, %lu lines skipped, %lu us\n",
+                script_lines, commands_run - script_commands, commands_unknown - script_unknown,
+                commands_failed - script_failed, script_skipped, elapsed_us);
+    } else {
+        log_msg("Usage: script begin|end\n");
+    }
+    return 0;
+}
+
+// Final character of ESC [ <param> x or ESC O x
+static void key_escape(char c, int param) {
+    switch (c) {
+        case 'A': key_history(1); break;                    // up
+        case 'B': key_history(-1); break;                   // down
+        case 'C': key_cursor(line_pos + 1); break;          // right
+        case 'D': key_cursor(line_pos - 1); break;          // left
+        case 'H': key_cursor(0); break;                     // home
+        case 'F': key_cursor(line_len); break;              // end
+        case '~':
+            if (param == 1 || param == 7) key_cursor(0);                // home
+            else if (param == 4 || param == 8) key_cursor(line_len);    // end
+            else if (param == 3) key_delete();                          // delete
+            break;
+        default:
+            break;
+    }
+}
+
 // Check for data available from USART interface.  If none present, just return.
-// If data available, process it (add it to character buffer if appropriate)
+// If data available, process it (edit the line in buffer[], or run it on <CR> / <LF>)
 void cl_loop(void)
 {
-    static int index = 0; // index into global buffer
+    static KEY_STATE key_state = KEY_STATE_NORMAL;
+    static int esc_param;
     int c;
 
-    // Spin, reading characters until EOF character is received (no data), buffer is full, or
-    // a <line feed> character is received.  Null terminate the global string, don't return the <LF>
+    // Spin, reading characters until EOF character is received (no data), or a line is complete.
+    // Null terminate the global string, don't return the <LF>
     while(1) {
       c = __io_getchar();
+      if (c != EOF && rpc_receive((uint8_t)c)) continue; // binary RPC frame, see rpc.c
+      if (c == EOF) {
+          echo_flush();
+          return; // non-blocking - return
+      }
+      if (script_active) {
+          script_char((char)c);
+          continue;
+      }
+      switch (key_state) {
+          case KEY_STATE_ESC:
+            key_state = (c == '[') ? KEY_STATE_CSI : (c == 'O') ? KEY_STATE_SS3 : KEY_STATE_NORMAL;
+            esc_param = 0;
+            continue;
+          case KEY_STATE_CSI:
+            if (c >= '0' && c <= '9') {
+                esc_param = (esc_param * 10) + (c - '0');
+                continue;
+            }
+            key_state = KEY_STATE_NORMAL;
+            key_escape((char)c, esc_param);
+            continue;
+          case KEY_STATE_SS3:
+            key_state = KEY_STATE_NORMAL;
+            key_escape((char)c, 0);
+            continue;
+          default:
+            break;
+      }
       switch(c) {
-          case EOF:
-              return; // non-blocking - return
+          case _ESC:
+            key_state = KEY_STATE_ESC;
+            break;
+          case _TAB:
+            key_tab();
+            break;
           case _CR:
           case _LF:
-            buffer[index] = 0; // null terminate
-            if(index) {
+            echo_flush();
+            console.buffer[line_len] = 0; // null terminate
+            if(line_len) {
+                cl_history_add(console.buffer, line_len);
         		log_msg("\n"); // newline
-            	cl_process_buffer(); // process the null terminated buffer
+            	cl_process_buffer(&console); // process the null terminated buffer
             }
-            log_msg("\n>");
-            index = 0; // reset buffer index
+            if (!script_active) log_msg("\n>"); // no prompt after "script begin"
+            line_len = 0; // reset buffer index
+            line_pos = 0;
+            hist_pos = -1;
             return;
           case _BS:
-            if(index<1) continue;
-            log_msg("\b \b"); // remove the previous character from the screen and buffer
-            index--;
+          case _DEL:
+            key_backspace();
             break;
           default:
-        	if(index<(MAXSERIALBUF - 1) && c >= ' ' && c <= '~') {
-                log_msg("%c",c); // write character to terminal
-                buffer[index] = (char) c;
-                index++;
+        	if(c >= ' ' && c <= '~') {
+                key_insert((char)c);
         	}
       } // switch
   } // while(1)
   return;
 } // cl_loop()
 
-void cl_process_buffer(void)
+// Run each ';' separated command in ctx->buffer[] in turn.  A ';' inside double quotes is part
+// of an argument.
+void cl_process_buffer(CL_CONTEXT *ctx)
+{
+    char *command = ctx->buffer;
+    while (command) {
+        char *p = command;
+        bool quoted = false;
+        for (; *p; p++) {
+            if (*p == '\"') quoted = !quoted;
+            else if (*p == ';' && !quoted) break;
+        }
+        char *next = *p ? p + 1 : NULL;
+        *p = 0;
+        cl_run_command(ctx, command);
+        command = next;
+    }
+}
+
+// Parse one command and its arguments into ctx->argc/argv[], and call its function
+static void cl_run_command(CL_CONTEXT *ctx, char *command)
 {
-    argc = cl_parseArgcArgv(buffer, argv, MAXWORDS);
+    ctx->argc = cl_parseArgcArgv(command, ctx->argv, MAXWORDS);
+    ctx->background = (ctx->argc > 1 && strcmp(ctx->argv[ctx->argc - 1], "&") == 0);
+    if (ctx->background) ctx->argc--;
     // Display each of the "words" / command and arguments
-    //for(int i=0;i<argc;i++)
-    //  log_msg("%d >%s<\n",i,argv[i]);
-    if (argc) {
+    //for(int i=0;i<ctx->argc;i++)
+    //  log_msg("%d >%s<\n",i,ctx->argv[i]);
+    if (ctx->argc) {
         // At least one "word" / argument found
         // See if command has a match in the command table
-        // If null command pointer found, exit for-loop
-        int cmdIndex;
-        for (cmdIndex = 0; cmd_table[cmdIndex].command; cmdIndex++) {
-            if (strcmp(argv[0], cmd_table[cmdIndex].command) == 0) {
-                // We found a match in the table
-                // Call the function associated with the command
-                (*cmd_table[cmdIndex].function)();
-                break; // exit for-loop
+        const COMMAND_ITEM * cmd = cl_find_command_prefix(ctx->argv[0]);
+        int ret;
+        commands_run++;
+        if (cmd == NULL) {
+            commands_unknown++;
+            int first;
+            int matches = cl_find_prefix(ctx->argv[0], strlen(ctx->argv[0]), &first);
+            if (matches > 1) {
+                log_msg("Command \"%s\" is ambiguous, %d matches\n", ctx->argv[0], matches);
+            } else {
+                log_msg("Command \"%s\" not found\n", ctx->argv[0]);
             }
-        } // for-loop
-          // If we compared all the command strings and didn't find the command, or we want to fake that event
-        if (!cmd_table[cmdIndex].command) {
-            log_msg("Command \"%s\" not found\n", argv[0]);
+        } else if (!cl_call(ctx, cmd, &ret)) {
+            commands_failed++;
+        } else if (ctx->background) {
+            log_msg("\"%s\" can't run in the background, it ran in the foreground\n", cmd->command);
         }
+        ctx->background = false;
     } // At least one "word" / argument found
 }
 
+// Set up a context for a command source.  Command output goes to output[] when given (see
+// cl_call()), otherwise to the console.
+void cl_context_init(CL_CONTEXT *ctx, char *output, uint32_t output_size)
+{
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->output = output;
+    ctx->output_size = output_size;
+}
+
+// Convert the arguments in ctx->argv[] with the command's schema, then call the command function
+// with its return value in *ret.  Everything printed meanwhile goes to ctx->output[] when the
+// context has one, with the length in ctx->output_len.  Return false, without calling the
+// function, if the arguments don't match the schema.
+bool cl_call(CL_CONTEXT *ctx, const COMMAND_ITEM *cmd, int *ret)
+{
+    bool ok;
+    ctx->command = cmd;
+    if (ctx->output) log_capture_start(ctx->output, ctx->output_size);
+    ok = (cl_convert_args(ctx, cmd) == 0);
+    if (ok) *ret = cmd->function(ctx);  // Call the function associated with the command
+    if (ctx->output) ctx->output_len = log_capture_stop();
+    return ok;
+}
+
+// Print "Usage: <command> <arg> [optional arg]" from the command's schema
+static void cl_usage(const COMMAND_ITEM * cmd) {
+    log_msg("Usage: %s", cmd->command);
+    for (const CL_ARG *a = cmd->args; a->name; a++) {
+        log_msg(a->def ? " [%s]" : " <%s>", a->name);
+    }
+    log_msg("\n");
+}
+
+// Check argv[] against the command's argument schema and convert each argument, or its default,
+// into ctx->args[].  Return 0, or -1 after printing what is wrong.  Commands without a schema get
+// their argv[] as it is.
+int cl_convert_args(CL_CONTEXT *ctx, const COMMAND_ITEM * cmd) {
+    int n;
+    if (cmd->args == NULL) return 0;
+    for (n = 0; cmd->args[n].name; n++) {
+        const CL_ARG *a = &cmd->args[n];
+        const char *text = (n + 1 < ctx->argc) ? ctx->argv[n + 1] : a->def;
+        bool ok = true;
+        if (text == NULL) {
+            cl_usage(cmd);
+            return -1;
+        }
+        switch (a->type) {
+            case CL_ARG_INT:
+                ok = parse_int(text, &ctx->args[n].i);
+                if (ok && (ctx->args[n].i < a->min || ctx->args[n].i > a->max)) {
+                    log_msg("%s: %s must be %ld to %ld\n", cmd->command, a->name, (long)a->min, (long)a->max);
+                    return -1;
+                }
+                break;
+            case CL_ARG_FLOAT:
+                ok = parse_float(text, &ctx->args[n].f);
+                if (ok && (ctx->args[n].f < (float)a->min || ctx->args[n].f > (float)a->max)) {
+                    log_msg("%s: %s must be %ld to %ld\n", cmd->command, a->name, (long)a->min, (long)a->max);
+                    return -1;
+                }
+                break;
+            case CL_ARG_STR:
+                ctx->args[n].s = text;
+                break;
+        }
+        if (!ok) {
+            log_msg("%s: %s \"%s\" is not %s\n", cmd->command, a->name, text,
+                    (a->type == CL_ARG_INT) ? "an integer" : "a number");
+            return -1;
+        }
+    }
+    if (ctx->argc > n + 1) {
+        cl_usage(cmd);
+        return -1;
+    }
+    return 0;
+}
+
 // Return true (non-zero) if character is a white space character
 int cl_isWhiteSpace(char c) {
   if(c==' ' || c=='\t' ||  c=='\r' || c=='\n' )
@@ -176,34 +729,32 @@ int cl_parseArgcArgv(char * inBuf,char **words, int count)
 } // parseArgcArgv()
 
 // We may want to add a comment/description field to the table to describe each command
-int cl_help(void) {
+int cl_help(CL_CONTEXT *ctx) {
     log_msg("Help - command list\n");
     log_msg("Command     Comment\n");
-    // Walk the command array, displaying each command
+    // Walk each registered command array, displaying each command
     // Continue until null function pointer found
-    for (int i = 0; cmd_table[i].command; i++) {
-        log_msg("%-12s%s\n",cmd_table[i].command,cmd_table[i].comment);
+    for (int t = 0; t < cmd_table_count; t++) {
+        for (int i = 0; cmd_tables[t][i].command; i++) {
+            log_msg("%-12s%s\n",cmd_tables[t][i].command,cmd_tables[t][i].comment);
+        }
     }
     log_msg("\n");
     return 0;
 }
 
 // Clear the screen
-int cl_cls(void) {
+int cl_cls(CL_CONTEXT *ctx) {
    // VT-100 command to clear the screen and move cursor to upper left corner
    log_msg("\x1B[2J\x1B[H");
    return 0;
 }
 
-int cl_add(void) {
-    // verify argument count, to remove it from the table
-    if(argc < 3) {
-        log_msg("\r\nInvalid Arg cnt: %d Expected: %d\n", argc - 1, 2);
-        return 0;
-    }
-    log_msg("add..  A: %s  B: %s\n", argv[1], argv[2]);
-    int A = (int) strtol(argv[1], NULL, 0); // allow user to use decimal or hex
-    int B = (int) strtol(argv[2], NULL, 0);
+// Arguments checked and converted by the add_args schema, decimal or hex
+int cl_add(CL_CONTEXT *ctx) {
+    int A = (int) ctx->args[0].i;
+    int B = (int) ctx->args[1].i;
+    log_msg("add..  A: %d  B: %d\n", A, B);
     int ret = A + B;
     log_msg("returning %d\n\n", ret);
     return ret;
@@ -221,7 +772,7 @@ The uniqueness of the serial number is guaranteed only when using all 128 bits.
 
 Read and display unique ID for SAME51 - 4 - 32-bit words (128 bits) */
 uint32_t unique_id[4]; // keep this as a global for now
-int cl_id(void) {
+int cl_id(CL_CONTEXT *ctx) {
     unique_id[0] = *(uint32_t *)0x008061FC;
     unique_id[1] = *(uint32_t *)0x00806010;
     unique_id[2] = *(uint32_t *)0x00806014;
@@ -233,7 +784,7 @@ int cl_id(void) {
 //#include "same51j20a.h"
 //#include "core_cm4.h"  // CMSIS header for Cortex-M4
 // Reset the processor
-int cl_reset(void) {
+int cl_reset(CL_CONTEXT *ctx) {
     NVIC_SystemReset(); // CMSIS Cortex-M4 function - see Drivers/CMSIS/Include/core_cm4.h
     // The above function has its own spin loop to wait for completion
     //while (1) ; // wait here until reset completes
@@ -242,7 +793,7 @@ int cl_reset(void) {
 
 // Compare multiple timers..  SYSTICK Timer, TC0 Timer, 
 // TC0 timer is running at 1MHz.  Rolls over every 71.58 minutes
-int cl_timer(void) {
+int cl_timer(CL_CONTEXT *ctx) {
     log_msg("%s(), Timing SYSTICK_DelayMs(50)\n",__func__);
     uint32_t start_us = TC0_Timer32bitCounterGet(); // read us hardware timer
     SYSTICK_DelayMs(50);
@@ -252,12 +803,49 @@ int cl_timer(void) {
     return 0;
 }
 
+// Compare the cost of finding every command using the sorted index against the original
+// linear strcmp() scan of the registered command tables.  Each command name is looked up LOOKUP_TEST_LOOPS times.
+#define LOOKUP_TEST_LOOPS 1000
+int cl_lookup_test(CL_CONTEXT *ctx) {
+    const COMMAND_ITEM * volatile found = NULL; // keep the compiler from discarding lookups
+    uint32_t lookups = (uint32_t)cmd_count * LOOKUP_TEST_LOOPS;
+
+    uint32_t start_us = TC0_Timer32bitCounterGet(); // read us hardware timer
+    for (int loop = 0; loop < LOOKUP_TEST_LOOPS; loop++) {
+        for (int i = 0; i < cmd_count; i++) {
+            for (int t = 0; t < cmd_table_count && found != cmd_index[i]; t++) {
+                for (int j = 0; cmd_tables[t][j].command; j++) {
+                    if (strcmp(cmd_index[i]->command, cmd_tables[t][j].command) == 0) {
+                        found = &cmd_tables[t][j];
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    uint32_t linear_us = TC0_Timer32bitCounterGet() - start_us;
+
+    start_us = TC0_Timer32bitCounterGet();
+    for (int loop = 0; loop < LOOKUP_TEST_LOOPS; loop++) {
+        for (int i = 0; i < cmd_count; i++) {
+            found = cl_find_command(cmd_index[i]->command);
+        }
+    }
+    uint32_t indexed_us = TC0_Timer32bitCounterGet() - start_us;
+    (void)found;
+
+    log_msg("%d commands, %lu lookups\n", cmd_count, lookups);
+    log_msg("Linear scan: %lu us, %lu ns/lookup\n", linear_us, (linear_us * 1000UL) / lookups);
+    log_msg("Indexed:     %lu us, %lu ns/lookup\n", indexed_us, (indexed_us * 1000UL) / lookups);
+    return 0;
+}
+
 //=================================================================================================
 // Read the Device Service Unit (DSU) - Device IDentification register (DID)
 // Expected value for Expected value for ATSAME51J20A: 0x61810304
 //=================================================================================================
 // My Curiosity Nano board displayed: Processor: 6, Family: 3, Series: 1, Die: 0, Revision: 3, Device: 4
-int cl_info(void) {
+int cl_info(CL_CONTEXT *ctx) {
     uint32_t did = DSU_REGS->DSU_DID;  // use header file defines
     uint8_t device    = (did & DSU_DID_DEVSEL_Msk)    >> DSU_DID_DEVSEL_Pos;
     uint8_t revision  = (did & DSU_DID_REVISION_Msk)  >> DSU_DID_REVISION_Pos;
@@ -269,7 +857,7 @@ int cl_info(void) {
     return 0;
 }
 
-int cl_version(void)
+int cl_version(CL_CONTEXT *ctx)
 {
 	log_msg("Version: %s\n",PROJECT_VERSION);
 	return 0;
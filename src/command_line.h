@@ -5,7 +5,8 @@
 
 #ifndef _command_line_h_
 #define _command_line_h_
-
+#include <stdbool.h>
+#include <stdint.h>
 
 // ANSI Examples: To get black letters on white background use ESC[30;47m
 // To get red use ESC[31m, to get bright red use ESC[1;31m
@@ -41,34 +42,96 @@
 #define _BS  '\b' /*(char)8 */
 #define _CR  '\r'
 #define _LF  '\n'
+#define _ESC '\x1B'
+#define _TAB '\t'
+#define _DEL '\x7F' /* sent by many terminals for the backspace key */
 
 // Defines
 #define MAXWORDS 10     // support up to 10 (command and parameters)
 #define MAXSERIALBUF 64 // Our command line will use a 64 byte buffer
+#define CL_MAX_COMMANDS 128 // size of the sorted command index, room for the fork's 80+ commands
+#define CL_MAX_TABLES   24 // number of command tables that may be registered
+#define CL_HISTORY_LINES 16     // command history lines kept
+#define CL_HISTORY_ARENA 512    // bytes shared by all command history lines
+
+// Typedefs
+typedef struct CL_CONTEXT CL_CONTEXT;
+
+// Argument schema: one CL_ARG per argument, ending with a NULL name.  The dispatcher checks and
+// converts the arguments into ctx->args[] before calling the command function, see cl_convert_args()
+typedef enum {
+  CL_ARG_INT,           // decimal or 0x hex, see parse_int()
+  CL_ARG_FLOAT,
+  CL_ARG_STR,
+} CL_ARG_TYPE;
+
+typedef struct {
+  const char * name;    // shown in the usage message
+  CL_ARG_TYPE type;
+  int32_t min;          // allowed range of CL_ARG_INT and CL_ARG_FLOAT values
+  int32_t max;
+  const char * def;     // value used when the argument is left out, NULL if it is required
+} CL_ARG;
+
+typedef union {
+  int32_t i;            // CL_ARG_INT
+  float f;              // CL_ARG_FLOAT
+  const char * s;       // CL_ARG_STR
+} CL_VALUE;
+
+typedef struct {
+  char * command;
+  char * comment;
+  int (*function)(CL_CONTEXT *ctx); // pointer to command function
+  const CL_ARG * args;  // argument schema, NULL if the function parses argv[] itself
+} COMMAND_ITEM;
+
+// A command source: the console, binary RPC, a background job.  Commands get the context they
+// were called from, and take their arguments from it.
+struct CL_CONTEXT {
+  char buffer[MAXSERIALBUF]; // command line, argv[] points into it
+  char * argv[MAXWORDS]; // command and arguments
+  int argc; // number of words (command & arguments)
+  CL_VALUE args[MAXWORDS]; // arguments converted with the command's schema, args[0] is argv[1]
+  bool background; // the command ended with "&", taken by job_run()
+  const COMMAND_ITEM * command; // the command being run
+  char * output; // output sink: log_msg() text is captured here, NULL for the console
+  uint32_t output_size;
+  uint32_t output_len; // captured by the last cl_call()
+};
 
 // Externs
-extern char buffer[]; // holds command strings from user
-extern char * argv[]; // pointers into buffer
-extern int argc; // number of words (command & arguments)
 extern int __io_getchar(void);             // main.c - read serial input
 
 // Forward declarations
 int cl_isWhiteSpace(char c);
 int cl_parseArgcArgv(char * inBuf,char **words, int count);
 void cl_setup(void);
+int cl_register(const COMMAND_ITEM * table);
 void cl_loop(void);
-void cl_process_buffer(void);
+void cl_process_buffer(CL_CONTEXT *ctx);
+void cl_context_init(CL_CONTEXT *ctx, char *output, uint32_t output_size);
+bool cl_call(CL_CONTEXT *ctx, const COMMAND_ITEM *cmd, int *ret);
+const COMMAND_ITEM * cl_find_command(const char * name);
+const COMMAND_ITEM * cl_index_find(const COMMAND_ITEM * const * index, int count, const char * name);
+const COMMAND_ITEM * cl_find_command_prefix(const char * name);
+int cl_find_prefix(const char * prefix, int len, int * first);
+const COMMAND_ITEM * cl_command_at(int position);
+int cl_convert_args(CL_CONTEXT *ctx, const COMMAND_ITEM * cmd);
+int cl_history_get(int n, char *line);
 
 // command line functions
-int cl_help(void);
-int cl_add(void);
-int cl_id(void);
-int cl_reset(void);
-int cl_timer(void);
-int cl_info(void);
-int cl_version(void);
-int cl_cls(void);
+int cl_help(CL_CONTEXT *ctx);
+int cl_add(CL_CONTEXT *ctx);
+int cl_id(CL_CONTEXT *ctx);
+int cl_reset(CL_CONTEXT *ctx);
+int cl_timer(CL_CONTEXT *ctx);
+int cl_info(CL_CONTEXT *ctx);
+int cl_version(CL_CONTEXT *ctx);
+int cl_cls(CL_CONTEXT *ctx);
+int cl_lookup_test(CL_CONTEXT *ctx);
+int cl_history(CL_CONTEXT *ctx);
+int cl_script(CL_CONTEXT *ctx);
 void text_in_box(const char *text, const char *color);
-int cl_logger_test(void);       // logger.c
 
 #endif // _command_line_h_
@@ -55,8 +55,10 @@
 #include "peripheral/nvic/plib_nvic.h"
 #include "peripheral/systick/plib_systick.h"
 #include "peripheral/cmcc/plib_cmcc.h"
+#include "peripheral/dmac/plib_dmac.h"
 #include "peripheral/sercom/usart/plib_sercom5_usart.h"
 #include "peripheral/tc/plib_tc0.h"
+#include "peripheral/tc/plib_tc2.h"
 
 // DOM-IGNORE-BEGIN
 #ifdef __cplusplus  // Provide C++ Compatibility
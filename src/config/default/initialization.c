@@ -141,6 +141,10 @@ void SYS_Initialize ( void* data )
 
     EVSYS_Initialize();
 
+    DMAC_Initialize();
+
+    TC2_TimerInitialize();
+
 	 SYSTICK_TimerInitialize();
     SERCOM5_USART_Initialize();
 
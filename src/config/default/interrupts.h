@@ -64,7 +64,11 @@ void BusFault_Handler (void);
 void UsageFault_Handler (void);
 void DebugMonitor_Handler (void);
 void SysTick_Handler (void);
+void DMAC_0_InterruptHandler (void);
+void DMAC_1_InterruptHandler (void);
 void SERCOM5_USART_InterruptHandler (void);
+void TC0_TimerInterruptHandler (void);
+void TC2_TimerInterruptHandler (void);
 
 
 
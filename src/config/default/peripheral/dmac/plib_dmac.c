@@ -0,0 +1,281 @@
+/*******************************************************************************
+  Direct Memory Access Controller (DMAC) PLIB
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    plib_dmac.c
+
+  Summary
+    Source for DMAC peripheral library interface Implementation.
+
+  Description
+    This file defines the interface to the DMAC peripheral library. This
+    library provides access to and control of the DMAC controller.
+
+  Remarks:
+    None.
+
+*******************************************************************************/
+
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "plib_dmac.h"
+#include "interrupts.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* DMAC channel object */
+typedef struct
+{
+    DMAC_CHANNEL_CALLBACK   callback;
+
+    uintptr_t               context;
+
+    bool                    busyStatus;
+
+} DMAC_CH_OBJECT;
+
+static volatile DMAC_CH_OBJECT dmacChannelObj[DMAC_CHANNELS_NUMBER];
+
+/* Initial and write back descriptors, one per configured channel. The DMAC
+ * requires both sections to be 128-bit aligned. */
+static dmac_descriptor_registers_t descriptor_section[DMAC_CHANNELS_NUMBER] __ALIGNED(16);
+static volatile dmac_descriptor_registers_t write_back_section[DMAC_CHANNELS_NUMBER] __ALIGNED(16);
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: DMAC PLib Interface Implementations
+// *****************************************************************************
+// *****************************************************************************
+
+void DMAC_Initialize( void )
+{
+    uint32_t channel;
+
+    /* Disable and reset the DMAC module */
+    DMAC_REGS->DMAC_CTRL &= (uint16_t)(~DMAC_CTRL_DMAENABLE_Msk);
+
+    while((DMAC_REGS->DMAC_CTRL & DMAC_CTRL_DMAENABLE_Msk) != 0U)
+    {
+        /* Wait for the module to be disabled */
+    }
+
+    DMAC_REGS->DMAC_CTRL = DMAC_CTRL_SWRST_Msk;
+
+    while((DMAC_REGS->DMAC_CTRL & DMAC_CTRL_SWRST_Msk) != 0U)
+    {
+        /* Wait for the reset to complete */
+    }
+
+    for (channel = 0U; channel < DMAC_CHANNELS_NUMBER; channel++)
+    {
+        dmacChannelObj[channel].callback = NULL;
+        dmacChannelObj[channel].context = 0U;
+        dmacChannelObj[channel].busyStatus = false;
+    }
+
+    /* Set the descriptor and write back memory sections */
+    DMAC_REGS->DMAC_BASEADDR = (uint32_t)descriptor_section;
+    DMAC_REGS->DMAC_WRBADDR  = (uint32_t)write_back_section;
+
+    /* Enable the DMAC module and all priority levels */
+    DMAC_REGS->DMAC_CTRL = DMAC_CTRL_DMAENABLE_Msk | DMAC_CTRL_LVLEN0_Msk | DMAC_CTRL_LVLEN1_Msk | DMAC_CTRL_LVLEN2_Msk | DMAC_CTRL_LVLEN3_Msk;
+
+    /***************** Configure DMA channel 0 ********************/
+
+    /* SERCOM5 TX: one beat per DRE trigger */
+    DMAC_REGS->CHANNEL[0].DMAC_CHCTRLA = DMAC_CHCTRLA_TRIGACT_BURST | DMAC_CHCTRLA_TRIGSRC(SERCOM5_DMAC_ID_TX) | DMAC_CHCTRLA_BURSTLEN_SINGLE | DMAC_CHCTRLA_THRESHOLD_1BEAT;
+
+    DMAC_REGS->CHANNEL[0].DMAC_CHPRILVL = DMAC_CHPRILVL_PRILVL(0UL);
+
+    descriptor_section[0].DMAC_BTCTRL = (uint16_t)(DMAC_BTCTRL_BLOCKACT_INT | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_VALID_Msk | DMAC_BTCTRL_SRCINC_Msk);
+
+    descriptor_section[0].DMAC_DESCADDR = 0U;
+
+    DMAC_REGS->CHANNEL[0].DMAC_CHINTENSET = (uint8_t)(DMAC_CHINTENSET_TERR_Msk | DMAC_CHINTENSET_TCMPL_Msk);
+
+    /***************** Configure DMA channel 1 ********************/
+
+    /* SERCOM5 RX: one beat per RXC trigger */
+    DMAC_REGS->CHANNEL[1].DMAC_CHCTRLA = DMAC_CHCTRLA_TRIGACT_BURST | DMAC_CHCTRLA_TRIGSRC(SERCOM5_DMAC_ID_RX) | DMAC_CHCTRLA_BURSTLEN_SINGLE | DMAC_CHCTRLA_THRESHOLD_1BEAT;
+
+    DMAC_REGS->CHANNEL[1].DMAC_CHPRILVL = DMAC_CHPRILVL_PRILVL(1UL);
+
+    descriptor_section[1].DMAC_BTCTRL = (uint16_t)(DMAC_BTCTRL_BLOCKACT_NOACT | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_VALID_Msk | DMAC_BTCTRL_DSTINC_Msk);
+
+    descriptor_section[1].DMAC_DESCADDR = 0U;
+
+    DMAC_REGS->CHANNEL[1].DMAC_CHINTENSET = (uint8_t)(DMAC_CHINTENSET_TERR_Msk);
+}
+
+void DMAC_ChannelCallbackRegister( DMAC_CHANNEL channel, const DMAC_CHANNEL_CALLBACK callback, const uintptr_t context )
+{
+    dmacChannelObj[channel].callback = callback;
+
+    dmacChannelObj[channel].context = context;
+}
+
+/* Start a single block transfer of blockSize bytes. The source and/or
+ * destination address is advanced per beat according to the channel's
+ * SRCINC/DSTINC setting, so the descriptor takes the address just past the
+ * end of an incrementing buffer. Returns false if the channel is busy. */
+bool DMAC_ChannelTransfer( DMAC_CHANNEL channel, const void *srcAddr, const void *destAddr, size_t blockSize )
+{
+    bool returnStatus = false;
+    dmac_descriptor_registers_t *const pDesc = &descriptor_section[channel];
+    uint32_t srcAddress = (uint32_t)srcAddr;
+    uint32_t dstAddress = (uint32_t)destAddr;
+
+    if ((dmacChannelObj[channel].busyStatus == false) && (blockSize > 0U) && (blockSize <= 0xFFFFU))
+    {
+        dmacChannelObj[channel].busyStatus = true;
+
+        if ((pDesc->DMAC_BTCTRL & DMAC_BTCTRL_SRCINC_Msk) != 0U)
+        {
+            srcAddress += blockSize;
+        }
+
+        if ((pDesc->DMAC_BTCTRL & DMAC_BTCTRL_DSTINC_Msk) != 0U)
+        {
+            dstAddress += blockSize;
+        }
+
+        pDesc->DMAC_SRCADDR = srcAddress;
+        pDesc->DMAC_DSTADDR = dstAddress;
+        pDesc->DMAC_BTCNT = (uint16_t)blockSize;
+
+        /* Descriptor must be in memory before the channel fetches it */
+        __DMB();
+
+        DMAC_REGS->CHANNEL[channel].DMAC_CHCTRLA |= DMAC_CHCTRLA_ENABLE_Msk;
+
+        returnStatus = true;
+    }
+
+    return returnStatus;
+}
+
+/* As DMAC_ChannelTransfer(), but the descriptor is linked to itself so the
+ * block repeats until the channel is disabled. Used to fill a ring buffer;
+ * the write position is given by DMAC_ChannelGetTransferredCount(). */
+bool DMAC_ChannelCircularTransfer( DMAC_CHANNEL channel, const void *srcAddr, const void *destAddr, size_t blockSize )
+{
+    descriptor_section[channel].DMAC_DESCADDR = (uint32_t)&descriptor_section[channel];
+
+    /* Position reads as 0 until the first beat updates the write back section */
+    write_back_section[channel].DMAC_BTCNT = (uint16_t)blockSize;
+
+    return DMAC_ChannelTransfer(channel, srcAddr, destAddr, blockSize);
+}
+
+bool DMAC_ChannelIsBusy( DMAC_CHANNEL channel )
+{
+    return (dmacChannelObj[channel].busyStatus);
+}
+
+void DMAC_ChannelDisable( DMAC_CHANNEL channel )
+{
+    DMAC_REGS->CHANNEL[channel].DMAC_CHCTRLA &= ~DMAC_CHCTRLA_ENABLE_Msk;
+
+    while((DMAC_REGS->CHANNEL[channel].DMAC_CHCTRLA & DMAC_CHCTRLA_ENABLE_Msk) != 0U)
+    {
+        /* Wait for the channel to be disabled */
+    }
+
+    dmacChannelObj[channel].busyStatus = false;
+}
+
+/* Number of beats transferred in the current block */
+uint16_t DMAC_ChannelGetTransferredCount( DMAC_CHANNEL channel )
+{
+    uint16_t remaining;
+    uint32_t active = DMAC_REGS->DMAC_ACTIVE;
+
+    if (((active & DMAC_ACTIVE_ABUSY_Msk) != 0U) && (((active & DMAC_ACTIVE_ID_Msk) >> DMAC_ACTIVE_ID_Pos) == (uint32_t)channel))
+    {
+        /* Channel is transferring, the write back section is not up to date */
+        remaining = (uint16_t)((active & DMAC_ACTIVE_BTCNT_Msk) >> DMAC_ACTIVE_BTCNT_Pos);
+    }
+    else
+    {
+        remaining = write_back_section[channel].DMAC_BTCNT;
+    }
+
+    return (uint16_t)(descriptor_section[channel].DMAC_BTCNT - remaining);
+}
+
+static void DMAC_ChannelInterruptHandler( DMAC_CHANNEL channel )
+{
+    volatile DMAC_CH_OBJECT *dmacChObj = &dmacChannelObj[channel];
+    uint8_t chanIntFlagStatus = DMAC_REGS->CHANNEL[channel].DMAC_CHINTFLAG;
+    DMAC_TRANSFER_EVENT event = DMAC_TRANSFER_EVENT_NONE;
+
+    if ((chanIntFlagStatus & DMAC_CHINTFLAG_TERR_Msk) != 0U)
+    {
+        /* Channel is disabled by hardware on a bus error */
+        DMAC_REGS->CHANNEL[channel].DMAC_CHINTFLAG = DMAC_CHINTFLAG_TERR_Msk;
+        event = DMAC_TRANSFER_EVENT_ERROR;
+    }
+    else if ((chanIntFlagStatus & DMAC_CHINTFLAG_TCMPL_Msk) != 0U)
+    {
+        DMAC_REGS->CHANNEL[channel].DMAC_CHINTFLAG = DMAC_CHINTFLAG_TCMPL_Msk;
+        event = DMAC_TRANSFER_EVENT_COMPLETE;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    if (event != DMAC_TRANSFER_EVENT_NONE)
+    {
+        dmacChObj->busyStatus = false;
+
+        if (dmacChObj->callback != NULL)
+        {
+            dmacChObj->callback(event, dmacChObj->context);
+        }
+    }
+}
+
+void __attribute__((used)) DMAC_0_InterruptHandler( void )
+{
+    DMAC_ChannelInterruptHandler(DMAC_CHANNEL_0);
+}
+
+void __attribute__((used)) DMAC_1_InterruptHandler( void )
+{
+    DMAC_ChannelInterruptHandler(DMAC_CHANNEL_1);
+}
@@ -0,0 +1,174 @@
+/*******************************************************************************
+  Direct Memory Access Controller (DMAC) PLIB
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    plib_dmac.h
+
+  Summary
+    DMAC PLIB Header File
+
+  Description
+    This file defines the interface to the DMAC peripheral library. This
+    library provides access to and control of the DMAC controller.
+
+  Remarks:
+    None.
+
+*******************************************************************************/
+
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+
+#ifndef PLIB_DMAC_H    // Guards against multiple inclusion
+#define PLIB_DMAC_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "device.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Number of channels configured in this PLIB */
+#define DMAC_CHANNELS_NUMBER        2U
+
+// *****************************************************************************
+/* DMAC Channels
+
+  Summary:
+    Identifies the configured DMAC channels.
+
+  Description:
+    Channel 0 is the SERCOM5 USART transmitter (trigger SERCOM5_DMAC_ID_TX,
+    one beat per trigger, byte beats, source increment).
+    Channel 1 is the SERCOM5 USART receiver (trigger SERCOM5_DMAC_ID_RX,
+    one beat per trigger, byte beats, destination increment, no block
+    interrupt). It has the higher priority level so received bytes are
+    never held up by the transmitter.
+
+  Remarks:
+    None.
+*/
+
+typedef enum
+{
+    /* SERCOM5 USART transmit */
+    DMAC_CHANNEL_0 = 0,
+
+    /* SERCOM5 USART receive */
+    DMAC_CHANNEL_1 = 1,
+
+} DMAC_CHANNEL;
+
+// *****************************************************************************
+/* DMAC Transfer Events
+
+  Summary:
+    Identifies the event passed to the channel callback.
+
+  Description:
+    None.
+
+  Remarks:
+    None.
+*/
+
+typedef enum
+{
+    /* No event */
+    DMAC_TRANSFER_EVENT_NONE = 0,
+
+    /* Block transfer complete */
+    DMAC_TRANSFER_EVENT_COMPLETE = 1,
+
+    /* Bus error during the transfer */
+    DMAC_TRANSFER_EVENT_ERROR = 2
+
+} DMAC_TRANSFER_EVENT;
+
+// *****************************************************************************
+/* DMAC Channel Callback
+
+  Summary:
+    Function called from the DMAC channel interrupt when a transfer ends.
+
+  Description:
+    The channel is idle when the callback runs, so the callback may start the
+    next transfer with DMAC_ChannelTransfer().
+
+  Remarks:
+    None.
+*/
+
+typedef void (*DMAC_CHANNEL_CALLBACK)(DMAC_TRANSFER_EVENT event, uintptr_t contextHandle);
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+void DMAC_Initialize( void );
+
+void DMAC_ChannelCallbackRegister( DMAC_CHANNEL channel, const DMAC_CHANNEL_CALLBACK callback, const uintptr_t context );
+
+bool DMAC_ChannelTransfer( DMAC_CHANNEL channel, const void *srcAddr, const void *destAddr, size_t blockSize );
+
+bool DMAC_ChannelCircularTransfer( DMAC_CHANNEL channel, const void *srcAddr, const void *destAddr, size_t blockSize );
+
+bool DMAC_ChannelIsBusy( DMAC_CHANNEL channel );
+
+uint16_t DMAC_ChannelGetTransferredCount( DMAC_CHANNEL channel );
+
+void DMAC_ChannelDisable( DMAC_CHANNEL channel );
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif //PLIB_DMAC_H
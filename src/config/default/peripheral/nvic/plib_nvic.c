@@ -59,6 +59,10 @@ void NVIC_Initialize( void )
 
     /* Enable the interrupt sources and configure the priorities as configured
      * from within the "Interrupt Manager" of MHC. */
+    NVIC_SetPriority(DMAC_0_IRQn, 7);
+    NVIC_EnableIRQ(DMAC_0_IRQn);
+    NVIC_SetPriority(DMAC_1_IRQn, 7);
+    NVIC_EnableIRQ(DMAC_1_IRQn);
     NVIC_SetPriority(SERCOM5_0_IRQn, 7);
     NVIC_EnableIRQ(SERCOM5_0_IRQn);
     NVIC_SetPriority(SERCOM5_1_IRQn, 7);
@@ -67,6 +71,10 @@ void NVIC_Initialize( void )
     NVIC_EnableIRQ(SERCOM5_2_IRQn);
     NVIC_SetPriority(SERCOM5_OTHER_IRQn, 7);
     NVIC_EnableIRQ(SERCOM5_OTHER_IRQn);
+    NVIC_SetPriority(TC0_IRQn, 7);
+    NVIC_EnableIRQ(TC0_IRQn);
+    NVIC_SetPriority(TC2_IRQn, 7);
+    NVIC_EnableIRQ(TC2_IRQn);
 
     /* Enable Usage fault */
     SCB->SHCSR |= (SCB_SHCSR_USGFAULTENA_Msk);
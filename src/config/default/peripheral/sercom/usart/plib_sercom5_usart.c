@@ -48,8 +48,11 @@
 // *****************************************************************************
 // *****************************************************************************
 
+#include <string.h>
 #include "interrupts.h"
 #include "plib_sercom5_usart.h"
+#include "peripheral/dmac/plib_dmac.h"
+#include "peripheral/tc/plib_tc2.h"
 
 // *****************************************************************************
 // *****************************************************************************
@@ -60,6 +63,7 @@
 
 /* SERCOM5 USART baud value for 115200 Hz baud rate */
 #define SERCOM5_USART_INT_BAUD_VALUE            (63522UL)
+#define SERCOM5_USART_INT_BAUD_RATE             (115200UL)
 
 static volatile SERCOM_USART_RING_BUFFER_OBJECT sercom5USARTObj;
 
@@ -69,6 +73,14 @@ static volatile SERCOM_USART_RING_BUFFER_OBJECT sercom5USARTObj;
 // *****************************************************************************
 // *****************************************************************************
 
+/* 9-bit character support. The console is fixed at 8N1, so by default the
+ * ring buffers hold one byte per character, their sizes are compile time
+ * constants and the 9-bit paths are compiled out. Define as 1 to allow
+ * USART_DATA_9_BIT in SERCOM5_USART_SerialSetup(). */
+#ifndef SERCOM5_USART_9BIT_ENABLE
+#define SERCOM5_USART_9BIT_ENABLE           0
+#endif
+
 #define SERCOM5_USART_READ_BUFFER_SIZE      2048U
 #define SERCOM5_USART_READ_BUFFER_9BIT_SIZE     (2048U >> 1U)
 #define SERCOM5_USART_RX_INT_DISABLE()      SERCOM5_REGS->USART_INT.SERCOM_INTENCLR = SERCOM_USART_INT_INTENCLR_RXC_Msk
@@ -83,6 +95,73 @@ static volatile uint8_t SERCOM5_USART_ReadBuffer[SERCOM5_USART_READ_BUFFER_SIZE]
 
 static volatile uint8_t SERCOM5_USART_WriteBuffer[SERCOM5_USART_WRITE_BUFFER_SIZE];
 
+/* Ring buffer sizes in characters. Both are powers of two (also when halved
+ * for 9-bit mode), so indices wrap with a mask. */
+#if (SERCOM5_USART_READ_BUFFER_SIZE & (SERCOM5_USART_READ_BUFFER_SIZE - 1U)) != 0U
+#error "SERCOM5_USART_READ_BUFFER_SIZE must be a power of two"
+#endif
+#if (SERCOM5_USART_WRITE_BUFFER_SIZE & (SERCOM5_USART_WRITE_BUFFER_SIZE - 1U)) != 0U
+#error "SERCOM5_USART_WRITE_BUFFER_SIZE must be a power of two"
+#endif
+
+#if SERCOM5_USART_9BIT_ENABLE == 0
+#define SERCOM5_USART_RD_SIZE               SERCOM5_USART_READ_BUFFER_SIZE
+#define SERCOM5_USART_WR_SIZE               SERCOM5_USART_WRITE_BUFFER_SIZE
+#else
+#define SERCOM5_USART_RD_SIZE               sercom5USARTObj.rdBufferSize
+#define SERCOM5_USART_WR_SIZE               sercom5USARTObj.wrBufferSize
+#endif
+#define SERCOM5_USART_RD_MASK               (SERCOM5_USART_RD_SIZE - 1U)
+#define SERCOM5_USART_WR_MASK               (SERCOM5_USART_WR_SIZE - 1U)
+
+/* DMA transmitter. In 8-bit mode the pending bytes of the write ring buffer
+ * are handed to the DMA in contiguous blocks, so there is one interrupt per
+ * block instead of one per byte. Blocks are capped so that space in the ring
+ * buffer is returned to writers while a long message is being sent. */
+#define SERCOM5_USART_TX_DMA_CHANNEL        DMAC_CHANNEL_0
+#define SERCOM5_USART_TX_DMA_BLOCK_SIZE     256U
+
+static volatile bool sercom5USARTTxDmaEnabled = true;
+static volatile uint32_t sercom5USARTTxDmaSize;     /* Bytes in flight, 0 when the channel is idle */
+
+/* DMA receiver. In 8-bit mode the read ring buffer is filled by a circular
+ * DMA transfer and the read in index follows the DMA, so there are no per-byte
+ * interrupts. The start of frame (RXS) interrupt of the first character of a
+ * burst starts TC2, which polls the DMA every millisecond and notifies the
+ * reader at each poll that finds new bytes, until the line goes idle. The
+ * first poll comes two character times after the start of frame instead, so a
+ * keystroke reaches the reader within two character times of when the RXC
+ * interrupt would have delivered it, not after a millisecond or more. */
+#define SERCOM5_USART_RX_DMA_CHANNEL        DMAC_CHANNEL_1
+#define SERCOM5_USART_RX_FIRST_POLL_BITS    (24U)   /* two characters of up to 12 bits */
+#define SERCOM5_USART_RXS_INT_DISABLE()     SERCOM5_REGS->USART_INT.SERCOM_INTENCLR = SERCOM_USART_INT_INTENCLR_RXS_Msk
+#define SERCOM5_USART_RXS_INT_ENABLE()      SERCOM5_REGS->USART_INT.SERCOM_INTENSET = SERCOM_USART_INT_INTENSET_RXS_Msk
+
+static volatile bool sercom5USARTRxDmaEnabled;
+static volatile uint32_t sercom5USARTRxDmaIndex;    /* DMA position at the last idle timer poll */
+static volatile uint32_t sercom5USARTRxDmaInCount;  /* bytes written by the DMA, counted at each poll */
+static volatile uint32_t sercom5USARTRxDmaOutCount; /* bytes taken by SERCOM5_USART_Read(), counted at each poll */
+static volatile uint32_t sercom5USARTRxDmaOutIndex; /* read out index at the last idle timer poll */
+static volatile bool sercom5USARTRxIdleCheck;       /* RXS re-armed, one more poll before the timer stops */
+static uint16_t sercom5USARTRxFirstPollTicks;       /* TC2 ticks from a start of frame to the first poll */
+
+static volatile SERCOM_USART_STATS sercom5USARTStats;
+
+static void SERCOM5_USART_TxDmaCallback(DMAC_TRANSFER_EVENT event, uintptr_t context);
+static void SERCOM5_USART_RxIdleTimerCallback(TC_TIMER_STATUS status, uintptr_t context);
+static void SERCOM5_USART_RxDmaStart(void);
+static void SERCOM5_USART_RxFirstPollSet(uint32_t baudRate);
+
+/* Constant true unless 9-bit support is compiled in */
+static inline bool SERCOM5_USART_Is8Bit(void)
+{
+#if SERCOM5_USART_9BIT_ENABLE == 0
+    return true;
+#else
+    return (((SERCOM5_REGS->USART_INT.SERCOM_CTRLB & SERCOM_USART_INT_CTRLB_CHSIZE_Msk) >> SERCOM_USART_INT_CTRLB_CHSIZE_Pos) != 0x01U);
+#endif
+}
+
 void SERCOM5_USART_Initialize( void )
 {
     /*
@@ -104,8 +183,9 @@ void SERCOM5_USART_Initialize( void )
      * Configures CHSIZE
      * Configures Parity
      * Configures Stop bits
+     * Configures Start of frame detection (RXS, used by the DMA receiver)
      */
-    SERCOM5_REGS->USART_INT.SERCOM_CTRLB = SERCOM_USART_INT_CTRLB_CHSIZE_8_BIT | SERCOM_USART_INT_CTRLB_SBMODE_1_BIT | SERCOM_USART_INT_CTRLB_RXEN_Msk | SERCOM_USART_INT_CTRLB_TXEN_Msk;
+    SERCOM5_REGS->USART_INT.SERCOM_CTRLB = SERCOM_USART_INT_CTRLB_CHSIZE_8_BIT | SERCOM_USART_INT_CTRLB_SBMODE_1_BIT | SERCOM_USART_INT_CTRLB_RXEN_Msk | SERCOM_USART_INT_CTRLB_TXEN_Msk | SERCOM_USART_INT_CTRLB_SFDE_Msk;
 
     /* Wait for sync */
     while((SERCOM5_REGS->USART_INT.SERCOM_SYNCBUSY) != 0U)
@@ -137,7 +217,9 @@ void SERCOM5_USART_Initialize( void )
     sercom5USARTObj.isWrNotificationEnabled = false;
     sercom5USARTObj.isWrNotifyPersistently = false;
     sercom5USARTObj.wrThreshold = 0U;
-    if (((SERCOM5_REGS->USART_INT.SERCOM_CTRLB & SERCOM_USART_INT_CTRLB_CHSIZE_Msk) >> SERCOM_USART_INT_CTRLB_CHSIZE_Pos) != 0x01U)
+    sercom5USARTTxDmaSize = 0U;
+    DMAC_ChannelCallbackRegister(SERCOM5_USART_TX_DMA_CHANNEL, SERCOM5_USART_TxDmaCallback, 0U);
+    if (SERCOM5_USART_Is8Bit() == true)
     {
         sercom5USARTObj.rdBufferSize = SERCOM5_USART_READ_BUFFER_SIZE;
         sercom5USARTObj.wrBufferSize = SERCOM5_USART_WRITE_BUFFER_SIZE;
@@ -150,8 +232,20 @@ void SERCOM5_USART_Initialize( void )
     /* Enable error interrupt */
     SERCOM5_REGS->USART_INT.SERCOM_INTENSET = (uint8_t)SERCOM_USART_INT_INTENSET_ERROR_Msk;
 
-    /* Enable Receive Complete interrupt */
-    SERCOM5_REGS->USART_INT.SERCOM_INTENSET = (uint8_t)SERCOM_USART_INT_INTENSET_RXC_Msk;
+    TC2_TimerCallbackRegister(SERCOM5_USART_RxIdleTimerCallback, 0U);
+    SERCOM5_USART_RxFirstPollSet(SERCOM5_USART_INT_BAUD_RATE);
+    sercom5USARTRxIdleCheck = false;
+    sercom5USARTRxDmaEnabled = SERCOM5_USART_Is8Bit();
+
+    if (sercom5USARTRxDmaEnabled == true)
+    {
+        SERCOM5_USART_RxDmaStart();
+    }
+    else
+    {
+        /* Enable Receive Complete interrupt */
+        SERCOM5_REGS->USART_INT.SERCOM_INTENSET = (uint8_t)SERCOM_USART_INT_INTENSET_RXC_Msk;
+    }
 }
 
 uint32_t SERCOM5_USART_FrequencyGet( void )
@@ -166,8 +260,14 @@ bool SERCOM5_USART_SerialSetup( USART_SERIAL_SETUP * serialSetup, uint32_t clkFr
     uint32_t sampleRate    = 0U;
     uint32_t sampleCount   = 0U;
 
-    if((serialSetup != NULL) && (serialSetup->baudRate != 0U))
+    if((serialSetup != NULL) && (serialSetup->baudRate != 0U) && ((SERCOM5_USART_9BIT_ENABLE != 0) || (serialSetup->dataWidth != USART_DATA_9_BIT)))
     {
+        if(serialSetup->dataWidth == USART_DATA_9_BIT)
+        {
+            /* The DMA receiver is 8-bit only */
+            (void)SERCOM5_USART_RxDmaEnable(false);
+        }
+
         if(clkFrequency == 0U)
         {
             clkFrequency = SERCOM5_USART_FrequencyGet();
@@ -205,6 +305,7 @@ bool SERCOM5_USART_SerialSetup( USART_SERIAL_SETUP * serialSetup, uint32_t clkFr
 
         /* Configure Baud Rate */
         SERCOM5_REGS->USART_INT.SERCOM_BAUD = (uint16_t)SERCOM_USART_INT_BAUD_BAUD(baudValue);
+        SERCOM5_USART_RxFirstPollSet(serialSetup->baudRate);
 
         /* Configure Parity Options */
         if(serialSetup->parity == USART_PARITY_NONE)
@@ -234,7 +335,7 @@ bool SERCOM5_USART_SerialSetup( USART_SERIAL_SETUP * serialSetup, uint32_t clkFr
         }
 
 
-        if (((SERCOM5_REGS->USART_INT.SERCOM_CTRLB & SERCOM_USART_INT_CTRLB_CHSIZE_Msk) >> SERCOM_USART_INT_CTRLB_CHSIZE_Pos) != 0x01U)
+        if (SERCOM5_USART_Is8Bit() == true)
         {
             sercom5USARTObj.rdBufferSize = SERCOM5_USART_READ_BUFFER_SIZE;
             sercom5USARTObj.wrBufferSize = SERCOM5_USART_WRITE_BUFFER_SIZE;
@@ -316,12 +417,7 @@ static inline bool SERCOM5_USART_RxPushByte(uint16_t rdByte)
     uint32_t rdInIdx;
     bool isSuccess = false;
 
-    tempInIndex = sercom5USARTObj.rdInIndex + 1U;
-
-    if (tempInIndex >= sercom5USARTObj.rdBufferSize)
-    {
-        tempInIndex = 0U;
-    }
+    tempInIndex = (sercom5USARTObj.rdInIndex + 1U) & SERCOM5_USART_RD_MASK;
 
     if (tempInIndex == sercom5USARTObj.rdOutIndex)
     {
@@ -332,19 +428,14 @@ static inline bool SERCOM5_USART_RxPushByte(uint16_t rdByte)
             sercom5USARTObj.rdCallback(SERCOM_USART_EVENT_READ_BUFFER_FULL, rdContext);
 
             /* Read the indices again in case application has freed up space in RX ring buffer */
-            tempInIndex = sercom5USARTObj.rdInIndex + 1U;
-
-            if (tempInIndex >= sercom5USARTObj.rdBufferSize)
-            {
-                tempInIndex = 0U;
-            }
+            tempInIndex = (sercom5USARTObj.rdInIndex + 1U) & SERCOM5_USART_RD_MASK;
         }
     }
 
     /* Attempt to push the data into the ring buffer */
     if (tempInIndex != sercom5USARTObj.rdOutIndex)
     {
-        if (((SERCOM5_REGS->USART_INT.SERCOM_CTRLB & SERCOM_USART_INT_CTRLB_CHSIZE_Msk) >> SERCOM_USART_INT_CTRLB_CHSIZE_Pos) != 0x01U)
+        if (SERCOM5_USART_Is8Bit() == true)
         {
             /* 8-bit */
             rdInIdx = sercom5USARTObj.rdInIndex;
@@ -371,6 +462,98 @@ static inline bool SERCOM5_USART_RxPushByte(uint16_t rdByte)
     return isSuccess;
 }
 
+/* Ring buffer index the receive DMA writes next */
+static inline uint32_t SERCOM5_USART_RxDmaIndexGet(void)
+{
+    /* A full block (end of the lap) is index 0 */
+    return (uint32_t)DMAC_ChannelGetTransferredCount(SERCOM5_USART_RX_DMA_CHANNEL) & SERCOM5_USART_RD_MASK;
+}
+
+/* In DMA mode the read in index is not pushed by an ISR, bring it up to date */
+static inline void SERCOM5_USART_RxDmaIndexUpdate(void)
+{
+    if (sercom5USARTRxDmaEnabled == true)
+    {
+        sercom5USARTObj.rdInIndex = SERCOM5_USART_RxDmaIndexGet();
+    }
+}
+
+/* TC2 ticks for two characters at baudRate, no more than the poll period */
+static void SERCOM5_USART_RxFirstPollSet(uint32_t baudRate)
+{
+    uint32_t period = (uint32_t)TC2_Timer16bitPeriodGet();
+    uint32_t ticks = ((TC2_TimerFrequencyGet() * SERCOM5_USART_RX_FIRST_POLL_BITS) / baudRate) + 1U;
+
+    sercom5USARTRxFirstPollTicks = (uint16_t)((ticks < period) ? ticks : period);
+}
+
+/* Start the circular receive DMA with an empty ring buffer. The DMA writes
+ * from the start of the buffer, so both indices are reset. */
+static void SERCOM5_USART_RxDmaStart(void)
+{
+    sercom5USARTObj.rdInIndex = 0U;
+    sercom5USARTObj.rdOutIndex = 0U;
+    sercom5USARTRxDmaIndex = 0U;
+    sercom5USARTRxDmaInCount = 0U;
+    sercom5USARTRxDmaOutCount = 0U;
+    sercom5USARTRxDmaOutIndex = 0U;
+    sercom5USARTRxIdleCheck = false;
+
+    (void)DMAC_ChannelCircularTransfer(SERCOM5_USART_RX_DMA_CHANNEL, (const void*)&SERCOM5_REGS->USART_INT.SERCOM_DATA, (const void*)SERCOM5_USART_ReadBuffer, SERCOM5_USART_RD_SIZE);
+
+    /* Wake on the start of the next frame */
+    SERCOM5_REGS->USART_INT.SERCOM_INTFLAG = (uint8_t)SERCOM_USART_INT_INTFLAG_RXS_Msk;
+    SERCOM5_USART_RXS_INT_ENABLE();
+}
+
+/* Select the DMA (true) or per-byte interrupt (false) receiver. Switching to
+ * the DMA needs 8-bit mode and an empty read buffer, returns false otherwise. */
+bool SERCOM5_USART_RxDmaEnable(bool isEnabled)
+{
+    bool isSuccess = true;
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    if (isEnabled != sercom5USARTRxDmaEnabled)
+    {
+        if (isEnabled == true)
+        {
+            if ((SERCOM5_USART_Is8Bit() == true) && (SERCOM5_USART_ReadCountGet() == 0U))
+            {
+                SERCOM5_USART_RX_INT_DISABLE();
+                sercom5USARTRxDmaEnabled = true;
+                SERCOM5_USART_RxDmaStart();
+            }
+            else
+            {
+                isSuccess = false;
+            }
+        }
+        else
+        {
+            SERCOM5_USART_RXS_INT_DISABLE();
+            TC2_TimerStop();
+            sercom5USARTRxIdleCheck = false;
+
+            DMAC_ChannelDisable(SERCOM5_USART_RX_DMA_CHANNEL);
+            sercom5USARTObj.rdInIndex = SERCOM5_USART_RxDmaIndexGet();
+            sercom5USARTRxDmaEnabled = false;
+
+            SERCOM5_USART_RX_INT_ENABLE();
+        }
+    }
+
+    __set_PRIMASK(primask);
+
+    return isSuccess;
+}
+
+bool SERCOM5_USART_RxDmaIsEnabled(void)
+{
+    return sercom5USARTRxDmaEnabled;
+}
+
 /* This routine is only called from ISR. Hence do not disable/enable USART interrupts. */
 static void SERCOM5_USART_ReadNotificationSend(void)
 {
@@ -388,6 +571,7 @@ static void SERCOM5_USART_ReadNotificationSend(void)
             {
                 if (nUnreadBytesAvailable >= sercom5USARTObj.rdThreshold)
                 {
+                    sercom5USARTStats.rxNotifications++;
                     sercom5USARTObj.rdCallback(SERCOM_USART_EVENT_READ_THRESHOLD_REACHED, rdContext);
                 }
             }
@@ -395,6 +579,7 @@ static void SERCOM5_USART_ReadNotificationSend(void)
             {
                 if (nUnreadBytesAvailable == sercom5USARTObj.rdThreshold)
                 {
+                    sercom5USARTStats.rxNotifications++;
                     sercom5USARTObj.rdCallback(SERCOM_USART_EVENT_READ_THRESHOLD_REACHED, rdContext);
                 }
             }
@@ -407,45 +592,45 @@ size_t SERCOM5_USART_Read(uint8_t* pRdBuffer, const size_t size)
     size_t nBytesRead = 0U;
     uint32_t rdOutIndex;
     uint32_t rdInIndex;
-    uint32_t rdOutIdx;
-    uint32_t nBytesReadIdx;
+
+    SERCOM5_USART_RxDmaIndexUpdate();
 
     /* Take a snapshot of indices to avoid creation of critical section */
 
     rdOutIndex = sercom5USARTObj.rdOutIndex;
     rdInIndex = sercom5USARTObj.rdInIndex;
 
-    while (nBytesRead < size)
+    if (SERCOM5_USART_Is8Bit() == true)
     {
-        if (rdOutIndex != rdInIndex)
-        {
-            if (((SERCOM5_REGS->USART_INT.SERCOM_CTRLB & SERCOM_USART_INT_CTRLB_CHSIZE_Msk) >> SERCOM_USART_INT_CTRLB_CHSIZE_Pos) != 0x01U)
-            {
-                pRdBuffer[nBytesRead] = SERCOM5_USART_ReadBuffer[rdOutIndex];
-                nBytesRead += 1U;
-                rdOutIndex += 1U;
-            }
-            else
-            {
-                rdOutIdx = rdOutIndex << 1U;
-                nBytesReadIdx = nBytesRead << 1U;
+        /* Copy the unread data as up to two contiguous runs, up to the end
+         * of the buffer and then from the start */
+        size_t nUnread = (rdInIndex - rdOutIndex) & SERCOM5_USART_RD_MASK;
+        size_t nToEnd = SERCOM5_USART_RD_SIZE - rdOutIndex;
+        size_t nFirst;
 
-                pRdBuffer[nBytesReadIdx] = SERCOM5_USART_ReadBuffer[rdOutIdx];
-                pRdBuffer[nBytesReadIdx + 1U] = SERCOM5_USART_ReadBuffer[rdOutIdx + 1U];
+        nBytesRead = (size < nUnread) ? size : nUnread;
+        nFirst = (nBytesRead < nToEnd) ? nBytesRead : nToEnd;
 
-                rdOutIndex += 1U;
-                nBytesRead += 1U;
-            }
+        (void)memcpy(pRdBuffer, (const uint8_t*)&SERCOM5_USART_ReadBuffer[rdOutIndex], nFirst);
+        (void)memcpy(&pRdBuffer[nFirst], (const uint8_t*)&SERCOM5_USART_ReadBuffer[0], nBytesRead - nFirst);
 
-            if (rdOutIndex >= sercom5USARTObj.rdBufferSize)
-            {
-                rdOutIndex = 0U;
-            }
-        }
-        else
+        rdOutIndex = (rdOutIndex + nBytesRead) & SERCOM5_USART_RD_MASK;
+    }
+    else
+    {
+        uint32_t rdOutIdx;
+        uint32_t nBytesReadIdx;
+
+        while ((nBytesRead < size) && (rdOutIndex != rdInIndex))
         {
-            /* No more data available in the RX buffer */
-            break;
+            rdOutIdx = rdOutIndex << 1U;
+            nBytesReadIdx = nBytesRead << 1U;
+
+            pRdBuffer[nBytesReadIdx] = SERCOM5_USART_ReadBuffer[rdOutIdx];
+            pRdBuffer[nBytesReadIdx + 1U] = SERCOM5_USART_ReadBuffer[rdOutIdx + 1U];
+
+            rdOutIndex = (rdOutIndex + 1U) & SERCOM5_USART_RD_MASK;
+            nBytesRead += 1U;
         }
     }
 
@@ -456,34 +641,26 @@ size_t SERCOM5_USART_Read(uint8_t* pRdBuffer, const size_t size)
 
 size_t SERCOM5_USART_ReadCountGet(void)
 {
-    size_t nUnreadBytesAvailable;
     uint32_t rdOutIndex;
     uint32_t rdInIndex;
 
+    SERCOM5_USART_RxDmaIndexUpdate();
+
     /* Take a snapshot of indices to avoid creation of critical section */
     rdOutIndex = sercom5USARTObj.rdOutIndex;
     rdInIndex = sercom5USARTObj.rdInIndex;
 
-    if ( rdInIndex >=  rdOutIndex)
-    {
-        nUnreadBytesAvailable =  rdInIndex - rdOutIndex;
-    }
-    else
-    {
-        nUnreadBytesAvailable =  (sercom5USARTObj.rdBufferSize -  rdOutIndex) + rdInIndex;
-    }
-
-    return nUnreadBytesAvailable;
+    return (rdInIndex - rdOutIndex) & SERCOM5_USART_RD_MASK;
 }
 
 size_t SERCOM5_USART_ReadFreeBufferCountGet(void)
 {
-    return (sercom5USARTObj.rdBufferSize - 1U) - SERCOM5_USART_ReadCountGet();
+    return (SERCOM5_USART_RD_SIZE - 1U) - SERCOM5_USART_ReadCountGet();
 }
 
 size_t SERCOM5_USART_ReadBufferSizeGet(void)
 {
-    return (sercom5USARTObj.rdBufferSize - 1U);
+    return (SERCOM5_USART_RD_SIZE - 1U);
 }
 
 bool SERCOM5_USART_ReadNotificationEnable(bool isEnabled, bool isPersistent)
@@ -536,27 +713,18 @@ static bool SERCOM5_USART_TxPullByte(void* pWrData)
 
     if (wrOutIndex != wrInIndex)
     {
-        if (((SERCOM5_REGS->USART_INT.SERCOM_CTRLB & SERCOM_USART_INT_CTRLB_CHSIZE_Msk) >> SERCOM_USART_INT_CTRLB_CHSIZE_Pos) != 0x01U)
+        if (SERCOM5_USART_Is8Bit() == true)
         {
             *pWrByte = SERCOM5_USART_WriteBuffer[wrOutIndex];
-            wrOutIndex++;
         }
         else
         {
             wrOutIdx = wrOutIndex << 1U;
             pWrByte[0] = SERCOM5_USART_WriteBuffer[wrOutIdx];
             pWrByte[1] = SERCOM5_USART_WriteBuffer[wrOutIdx + 1U];
-
-            wrOutIndex++;
         }
 
-
-        if (wrOutIndex >= sercom5USARTObj.wrBufferSize)
-        {
-            wrOutIndex = 0U;
-        }
-
-        sercom5USARTObj.wrOutIndex = wrOutIndex;
+        sercom5USARTObj.wrOutIndex = (wrOutIndex + 1U) & SERCOM5_USART_WR_MASK;
 
         isSuccess = true;
     }
@@ -573,15 +741,11 @@ static inline bool SERCOM5_USART_TxPushByte(uint16_t wrByte)
 
     bool isSuccess = false;
 
-    tempInIndex = wrInIndex + 1U;
+    tempInIndex = (wrInIndex + 1U) & SERCOM5_USART_WR_MASK;
 
-    if (tempInIndex >= sercom5USARTObj.wrBufferSize)
-    {
-        tempInIndex = 0U;
-    }
     if (tempInIndex != wrOutIndex)
     {
-        if (((SERCOM5_REGS->USART_INT.SERCOM_CTRLB & SERCOM_USART_INT_CTRLB_CHSIZE_Msk) >> SERCOM_USART_INT_CTRLB_CHSIZE_Pos) != 0x01U)
+        if (SERCOM5_USART_Is8Bit() == true)
         {
             SERCOM5_USART_WriteBuffer[wrInIndex] = (uint8_t)wrByte;
         }
@@ -639,22 +803,11 @@ static void SERCOM5_USART_SendWriteNotification(void)
 
 static size_t SERCOM5_USART_WritePendingBytesGet(void)
 {
-    size_t nPendingTxBytes;
-
     /* Take a snapshot of indices to avoid creation of critical section */
     uint32_t wrInIndex = sercom5USARTObj.wrInIndex;
     uint32_t wrOutIndex = sercom5USARTObj.wrOutIndex;
 
-    if ( wrInIndex >= wrOutIndex)
-    {
-        nPendingTxBytes =  wrInIndex - wrOutIndex;
-    }
-    else
-    {
-        nPendingTxBytes =  (sercom5USARTObj.wrBufferSize -  wrOutIndex) + wrInIndex;
-    }
-
-    return nPendingTxBytes;
+    return (wrInIndex - wrOutIndex) & SERCOM5_USART_WR_MASK;
 }
 
 size_t SERCOM5_USART_WriteCountGet(void)
@@ -670,21 +823,28 @@ size_t SERCOM5_USART_Write(uint8_t* pWrBuffer, const size_t size )
 {
     size_t nBytesWritten  = 0U;
 
-    while (nBytesWritten < size)
+    if (SERCOM5_USART_Is8Bit() == true)
     {
-        if (((SERCOM5_REGS->USART_INT.SERCOM_CTRLB & SERCOM_USART_INT_CTRLB_CHSIZE_Msk) >> SERCOM_USART_INT_CTRLB_CHSIZE_Pos) != 0x01U)
-        {
-            if (SERCOM5_USART_TxPushByte(pWrBuffer[nBytesWritten]) == true)
-            {
-                nBytesWritten++;
-            }
-            else
-            {
-                /* Queue is full, exit the loop */
-                break;
-            }
-        }
-        else
+        /* Copy into the free space as up to two contiguous runs, up to the
+         * end of the buffer and then from the start */
+        uint32_t wrInIndex = sercom5USARTObj.wrInIndex;
+        size_t nFree = SERCOM5_USART_WriteFreeBufferCountGet();
+        size_t nToEnd = SERCOM5_USART_WR_SIZE - wrInIndex;
+        size_t nFirst;
+
+        nBytesWritten = (size < nFree) ? size : nFree;
+        nFirst = (nBytesWritten < nToEnd) ? nBytesWritten : nToEnd;
+
+        (void)memcpy((uint8_t*)&SERCOM5_USART_WriteBuffer[wrInIndex], pWrBuffer, nFirst);
+        (void)memcpy((uint8_t*)&SERCOM5_USART_WriteBuffer[0], &pWrBuffer[nFirst], nBytesWritten - nFirst);
+
+        /* Data must be in the buffer before the ISR can see the new index */
+        __DMB();
+        sercom5USARTObj.wrInIndex = (wrInIndex + nBytesWritten) & SERCOM5_USART_WR_MASK;
+    }
+    else
+    {
+        while (nBytesWritten < size)
         {
             uint16_t halfWordData = (uint16_t)(pWrBuffer[(2U * nBytesWritten) + 1U]);
             halfWordData <<= 8U;
@@ -713,12 +873,61 @@ size_t SERCOM5_USART_Write(uint8_t* pWrBuffer, const size_t size )
 
 size_t SERCOM5_USART_WriteFreeBufferCountGet(void)
 {
-    return (sercom5USARTObj.wrBufferSize - 1U) - SERCOM5_USART_WriteCountGet();
+    return (SERCOM5_USART_WR_SIZE - 1U) - SERCOM5_USART_WriteCountGet();
 }
 
 size_t SERCOM5_USART_WriteBufferSizeGet(void)
 {
-    return (sercom5USARTObj.wrBufferSize - 1U);
+    return (SERCOM5_USART_WR_SIZE - 1U);
+}
+
+/* Zero-copy write, 8-bit mode only. Describe the free space of the TX ring
+ * buffer as up to two contiguous spans that the caller may fill in directly,
+ * then call SERCOM5_USART_WriteCommit() with the number of bytes written
+ * (first span, then second). Single producer: must not be used together with
+ * SERCOM5_USART_Write() from another context. Returns the number of spans. */
+uint32_t SERCOM5_USART_WriteSpanGet(SERCOM_USART_SPAN spans[2])
+{
+    uint32_t nSpans = 0U;
+    uint32_t wrInIndex = sercom5USARTObj.wrInIndex;
+    size_t nFree = SERCOM5_USART_WriteFreeBufferCountGet();
+
+    spans[0].size = 0U;
+    spans[1].size = 0U;
+
+    if ((nFree > 0U) && (SERCOM5_USART_Is8Bit() == true))
+    {
+        size_t nToEnd = SERCOM5_USART_WR_SIZE - wrInIndex;
+
+        spans[0].pData = (uint8_t*)&SERCOM5_USART_WriteBuffer[wrInIndex];
+        spans[0].size = (nFree < nToEnd) ? nFree : nToEnd;
+        nSpans = 1U;
+
+        if (nFree > spans[0].size)
+        {
+            spans[1].pData = (uint8_t*)&SERCOM5_USART_WriteBuffer[0];
+            spans[1].size = nFree - spans[0].size;
+            nSpans = 2U;
+        }
+    }
+
+    return nSpans;
+}
+
+/* Publish size bytes written into the spans returned by SERCOM5_USART_WriteSpanGet() */
+void SERCOM5_USART_WriteCommit(size_t size)
+{
+    uint32_t wrInIndex = (sercom5USARTObj.wrInIndex + (uint32_t)size) & SERCOM5_USART_WR_MASK;
+
+    /* Data must be in the buffer before the ISR can see the new index */
+    __DMB();
+    sercom5USARTObj.wrInIndex = wrInIndex;
+
+    if (size > 0U)
+    {
+        /* Enable TX interrupt as data is pending for transmission */
+        SERCOM5_USART_TX_INT_ENABLE();
+    }
 }
 
 bool SERCOM5_USART_WriteNotificationEnable(bool isEnabled, bool isPersistent)
@@ -747,6 +956,175 @@ void SERCOM5_USART_WriteCallbackRegister( SERCOM_USART_RING_BUFFER_CALLBACK call
     sercom5USARTObj.wrContext = context;
 }
 
+/* Select the DMA (true) or per-byte interrupt (false) transmitter. A block
+ * already in flight completes first. 9-bit mode always uses the interrupt. */
+void SERCOM5_USART_TxDmaEnable(bool isEnabled)
+{
+    sercom5USARTTxDmaEnabled = isEnabled;
+
+    if (SERCOM5_USART_WritePendingBytesGet() > 0U)
+    {
+        /* The TX interrupt hands pending data to whichever transmitter is selected */
+        SERCOM5_USART_TX_INT_ENABLE();
+    }
+}
+
+bool SERCOM5_USART_TxDmaIsEnabled(void)
+{
+    return sercom5USARTTxDmaEnabled;
+}
+
+void SERCOM5_USART_StatsGet(SERCOM_USART_STATS* pStats)
+{
+    *pStats = sercom5USARTStats;
+}
+
+void SERCOM5_USART_StatsReset(void)
+{
+    static const SERCOM_USART_STATS zeroStats = {0};
+    uint32_t primask = __get_PRIMASK();
+
+    /* The counters are updated from the SERCOM5 and DMAC interrupts */
+    __disable_irq();
+    sercom5USARTStats = zeroStats;
+    __set_PRIMASK(primask);
+}
+
+/* Ring buffer cost, for the application's benchmarks (8-bit characters). Runs
+ * one ring operation on size bytes of pBuffer with interrupts disabled, then
+ * puts the ring indices back, so data queued either way is not disturbed. The
+ * bytes pulled or read are whatever the buffers hold. Returns the number of
+ * bytes moved. */
+size_t SERCOM5_USART_RingBenchmark(SERCOM_USART_RING_OP op, uint8_t* pBuffer, const size_t size)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint32_t wrInIndex;
+    uint32_t wrOutIndex;
+    uint32_t rdInIndex;
+    uint32_t rdOutIndex;
+    bool rxDmaEnabled;
+    size_t nBytes = 0U;
+
+    __disable_irq();
+
+    wrInIndex = sercom5USARTObj.wrInIndex;
+    wrOutIndex = sercom5USARTObj.wrOutIndex;
+    rdInIndex = sercom5USARTObj.rdInIndex;
+    rdOutIndex = sercom5USARTObj.rdOutIndex;
+    rxDmaEnabled = sercom5USARTRxDmaEnabled;
+
+    if (op == SERCOM_USART_RING_OP_WRITE)
+    {
+        nBytes = SERCOM5_USART_Write(pBuffer, size);
+    }
+    else if (op == SERCOM_USART_RING_OP_PULL)
+    {
+        sercom5USARTObj.wrInIndex = (wrOutIndex + size) & SERCOM5_USART_WR_MASK;
+        while (SERCOM5_USART_TxPullByte(&pBuffer[nBytes]) == true)
+        {
+            nBytes++;
+        }
+    }
+    else
+    {
+        /* As if the bytes had arrived, without the DMA index taking over */
+        sercom5USARTRxDmaEnabled = false;
+        sercom5USARTObj.rdInIndex = (rdOutIndex + size) & SERCOM5_USART_RD_MASK;
+        nBytes = SERCOM5_USART_Read(pBuffer, size);
+    }
+
+    sercom5USARTObj.wrInIndex = wrInIndex;
+    sercom5USARTObj.wrOutIndex = wrOutIndex;
+    sercom5USARTObj.rdInIndex = rdInIndex;
+    sercom5USARTObj.rdOutIndex = rdOutIndex;
+    sercom5USARTRxDmaEnabled = rxDmaEnabled;
+
+    __set_PRIMASK(primask);
+
+    return nBytes;
+}
+
+/* This routine is only called from ISR. Start a DMA transfer of the next
+ * contiguous run of pending bytes. Returns false if there is nothing to send. */
+static bool SERCOM5_USART_TxDmaStart(void)
+{
+    uint32_t wrInIndex = sercom5USARTObj.wrInIndex;
+    uint32_t wrOutIndex = sercom5USARTObj.wrOutIndex;
+    uint32_t nBytes;
+    bool isStarted = false;
+
+    if (wrOutIndex != wrInIndex)
+    {
+        if (wrInIndex > wrOutIndex)
+        {
+            nBytes = wrInIndex - wrOutIndex;
+        }
+        else
+        {
+            /* Up to the end of the buffer, the rest goes in the next block */
+            nBytes = SERCOM5_USART_WR_SIZE - wrOutIndex;
+        }
+
+        if (nBytes > SERCOM5_USART_TX_DMA_BLOCK_SIZE)
+        {
+            nBytes = SERCOM5_USART_TX_DMA_BLOCK_SIZE;
+        }
+
+        sercom5USARTTxDmaSize = nBytes;
+
+        isStarted = DMAC_ChannelTransfer(SERCOM5_USART_TX_DMA_CHANNEL, (const void*)&SERCOM5_USART_WriteBuffer[wrOutIndex], (const void*)&SERCOM5_REGS->USART_INT.SERCOM_DATA, nBytes);
+
+        if (isStarted == false)
+        {
+            sercom5USARTTxDmaSize = 0U;
+        }
+    }
+
+    return isStarted;
+}
+
+/* DMA block complete. Called from the DMAC channel interrupt, which has the
+ * same priority as the SERCOM5 interrupt so the two never preempt each other. */
+static void SERCOM5_USART_TxDmaCallback(DMAC_TRANSFER_EVENT event, uintptr_t context)
+{
+    uint32_t startCycles = DWT->CYCCNT;
+    uint32_t nBytes = sercom5USARTTxDmaSize;
+    uint32_t wrOutIndex = (sercom5USARTObj.wrOutIndex + nBytes) & SERCOM5_USART_WR_MASK;
+
+    (void)context;
+
+    if (event == DMAC_TRANSFER_EVENT_ERROR)
+    {
+        /* Bytes are dropped rather than retried */
+        sercom5USARTStats.txDmaErrors++;
+    }
+
+    sercom5USARTObj.wrOutIndex = wrOutIndex;
+    sercom5USARTTxDmaSize = 0U;
+
+    sercom5USARTStats.txDmaBytes += nBytes;
+    sercom5USARTStats.txDmaBlocks++;
+
+    SERCOM5_USART_SendWriteNotification();
+
+    if ((sercom5USARTTxDmaEnabled == true) && SERCOM5_USART_Is8Bit())
+    {
+        (void)SERCOM5_USART_TxDmaStart();
+    }
+    else if (SERCOM5_USART_WritePendingBytesGet() > 0U)
+    {
+        /* Transmitter changed, continue with the TX interrupt */
+        SERCOM5_USART_TX_INT_ENABLE();
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    sercom5USARTStats.txDmaIsrCount++;
+    sercom5USARTStats.txDmaIsrCycles += DWT->CYCCNT - startCycles;
+}
+
 
 
 static void __attribute__((used)) SERCOM5_USART_ISR_ERR_Handler( void )
@@ -772,12 +1150,14 @@ static void __attribute__((used)) SERCOM5_USART_ISR_ERR_Handler( void )
 
 static void __attribute__((used)) SERCOM5_USART_ISR_RX_Handler( void )
 {
-
+    uint32_t startCycles = DWT->CYCCNT;
 
     while ((SERCOM5_REGS->USART_INT.SERCOM_INTFLAG & SERCOM_USART_INT_INTFLAG_RXC_Msk) == SERCOM_USART_INT_INTFLAG_RXC_Msk)
     {
         if (SERCOM5_USART_RxPushByte( (uint16_t)SERCOM5_REGS->USART_INT.SERCOM_DATA) == true)
         {
+            sercom5USARTStats.rxIsrBytes++;
+
             SERCOM5_USART_ReadNotificationSend();
         }
         else
@@ -785,33 +1165,154 @@ static void __attribute__((used)) SERCOM5_USART_ISR_RX_Handler( void )
             /* UART RX buffer is full */
         }
     }
+
+    sercom5USARTStats.rxIsrCount++;
+    sercom5USARTStats.rxIsrCycles += DWT->CYCCNT - startCycles;
+}
+
+/* Start of frame while the DMA receiver is idle: poll the DMA two character
+ * times from now, once the character is in, then every millisecond until the
+ * line goes idle again. If the timer is still running for the final poll of
+ * the last burst, it carries on with this one. */
+static void __attribute__((used)) SERCOM5_USART_ISR_RXS_Handler( void )
+{
+    uint32_t startCycles = DWT->CYCCNT;
+
+    SERCOM5_REGS->USART_INT.SERCOM_INTFLAG = (uint8_t)SERCOM_USART_INT_INTFLAG_RXS_Msk;
+    SERCOM5_USART_RXS_INT_DISABLE();
+
+    sercom5USARTRxIdleCheck = false;
+    TC2_Timer16bitCounterSet(TC2_Timer16bitPeriodGet() - sercom5USARTRxFirstPollTicks);
+    TC2_TimerStart();
+
+    sercom5USARTStats.rxDmaIsrCount++;
+    sercom5USARTStats.rxDmaIsrCycles += DWT->CYCCNT - startCycles;
+}
+
+/* TC2 period, every millisecond while a burst is being received. Called from
+ * the TC2 interrupt, which has the same priority as the SERCOM5 interrupt. */
+static void SERCOM5_USART_RxIdleTimerCallback(TC_TIMER_STATUS status, uintptr_t context)
+{
+    uint32_t startCycles = DWT->CYCCNT;
+    uint32_t rdBufferSize = SERCOM5_USART_RD_SIZE;
+    uint32_t lastIndex = sercom5USARTRxDmaIndex;
+    uint32_t lastOutIndex = sercom5USARTRxDmaOutIndex;
+    uint32_t dmaIndex = SERCOM5_USART_RxDmaIndexGet();
+    uint32_t rdOutIndex = sercom5USARTObj.rdOutIndex;
+    uint32_t nNewBytes;
+    uint32_t nUnreadBytes;
+
+    (void)status;
+    (void)context;
+
+    /* The poll period is much shorter than the time to fill the buffer, so
+     * the DMA has moved, and the reader has read, less than one lap since the
+     * last poll. Read() and ReadCountGet() take the DMA index themselves, so
+     * the reader may be past lastIndex: unread bytes are counted from the live
+     * read index. That can't show a lap of the ring, the running byte counts
+     * can. Both are kept here, Read() only moves the read out index. */
+    nNewBytes = (dmaIndex - lastIndex) & SERCOM5_USART_RD_MASK;
+    nUnreadBytes = (dmaIndex - rdOutIndex) & SERCOM5_USART_RD_MASK;
+
+    sercom5USARTRxDmaIndex = dmaIndex;
+    sercom5USARTRxDmaOutIndex = rdOutIndex;
+    sercom5USARTObj.rdInIndex = dmaIndex;
+    sercom5USARTRxDmaInCount += nNewBytes;
+    sercom5USARTRxDmaOutCount += (rdOutIndex - lastOutIndex) & SERCOM5_USART_RD_MASK;
+    sercom5USARTStats.rxDmaBytes += nNewBytes;
+
+    if ((sercom5USARTRxDmaInCount - sercom5USARTRxDmaOutCount) >= rdBufferSize)
+    {
+        /* The DMA has overwritten data that was not read yet. A lap is lost,
+         * the reader sees the bytes from its index to the DMA's. */
+        sercom5USARTRxDmaOutCount = sercom5USARTRxDmaInCount - nUnreadBytes;
+        sercom5USARTStats.rxDmaOverruns++;
+        sercom5USARTObj.errorStatus = USART_ERROR_OVERRUN;
+
+        if(sercom5USARTObj.rdCallback != NULL)
+        {
+            uintptr_t rdContext = sercom5USARTObj.rdContext;
+
+            sercom5USARTObj.rdCallback(SERCOM_USART_EVENT_READ_ERROR, rdContext);
+        }
+    }
+
+    if (nNewBytes != 0U)
+    {
+        /* Hand the new bytes to the reader, the burst carries on */
+        sercom5USARTRxIdleCheck = false;
+        SERCOM5_USART_ReadNotificationSend();
+    }
+    else if (sercom5USARTRxIdleCheck == true)
+    {
+        /* Still idle after the final poll */
+        TC2_TimerStop();
+        sercom5USARTRxIdleCheck = false;
+    }
+    else
+    {
+        /* Line idle. Re-arm the start of frame interrupt, and poll once more
+         * to pick up a character that started before RXS was re-armed. */
+        SERCOM5_REGS->USART_INT.SERCOM_INTFLAG = (uint8_t)SERCOM_USART_INT_INTFLAG_RXS_Msk;
+        SERCOM5_USART_RXS_INT_ENABLE();
+        sercom5USARTRxIdleCheck = true;
+    }
+
+    sercom5USARTStats.rxDmaIsrCount++;
+    sercom5USARTStats.rxDmaIsrCycles += DWT->CYCCNT - startCycles;
 }
 
 static void __attribute__((used)) SERCOM5_USART_ISR_TX_Handler( void )
 {
     uint16_t wrByte;
+    uint32_t startCycles = DWT->CYCCNT;
+
+    if (sercom5USARTTxDmaSize != 0U)
+    {
+        /* DMA block in flight, its completion sends whatever was queued behind it */
+        SERCOM5_USART_TX_INT_DISABLE();
 
-    while ((SERCOM5_REGS->USART_INT.SERCOM_INTFLAG & SERCOM_USART_INT_INTFLAG_DRE_Msk) == SERCOM_USART_INT_INTFLAG_DRE_Msk)
+        sercom5USARTStats.txDmaIsrCount++;
+        sercom5USARTStats.txDmaIsrCycles += DWT->CYCCNT - startCycles;
+    }
+    else if ((sercom5USARTTxDmaEnabled == true) && SERCOM5_USART_Is8Bit())
+    {
+        /* Hand the pending data to the DMA, the next interrupt is at block completion */
+        SERCOM5_USART_TX_INT_DISABLE();
+        (void)SERCOM5_USART_TxDmaStart();
+
+        sercom5USARTStats.txDmaIsrCount++;
+        sercom5USARTStats.txDmaIsrCycles += DWT->CYCCNT - startCycles;
+    }
+    else
     {
-        if (SERCOM5_USART_TxPullByte(&wrByte) == true)
+        while ((SERCOM5_REGS->USART_INT.SERCOM_INTFLAG & SERCOM_USART_INT_INTFLAG_DRE_Msk) == SERCOM_USART_INT_INTFLAG_DRE_Msk)
         {
-            if (((SERCOM5_REGS->USART_INT.SERCOM_CTRLB & SERCOM_USART_INT_CTRLB_CHSIZE_Msk) >> SERCOM_USART_INT_CTRLB_CHSIZE_Pos) != 0x01U)
+            if (SERCOM5_USART_TxPullByte(&wrByte) == true)
             {
-                SERCOM5_REGS->USART_INT.SERCOM_DATA = (uint8_t)wrByte;
+                if (SERCOM5_USART_Is8Bit() == true)
+                {
+                    SERCOM5_REGS->USART_INT.SERCOM_DATA = (uint8_t)wrByte;
+                }
+                else
+                {
+                    SERCOM5_REGS->USART_INT.SERCOM_DATA = wrByte;
+                }
+
+                sercom5USARTStats.txIsrBytes++;
+
+                SERCOM5_USART_SendWriteNotification();
             }
             else
             {
-                SERCOM5_REGS->USART_INT.SERCOM_DATA = wrByte;
+                /* Nothing to transmit. Disable the data register empty interrupt. */
+                SERCOM5_USART_TX_INT_DISABLE();
+                break;
             }
-
-            SERCOM5_USART_SendWriteNotification();
-        }
-        else
-        {
-            /* Nothing to transmit. Disable the data register empty interrupt. */
-            SERCOM5_USART_TX_INT_DISABLE();
-            break;
         }
+
+        sercom5USARTStats.txIsrCount++;
+        sercom5USARTStats.txIsrCycles += DWT->CYCCNT - startCycles;
     }
 }
 
@@ -836,6 +1337,14 @@ void __attribute__((used)) SERCOM5_USART_InterruptHandler( void )
             SERCOM5_USART_ISR_TX_Handler();
         }
 
+        /* Checks for receive start flag */
+        testCondition = ((SERCOM5_REGS->USART_INT.SERCOM_INTFLAG & SERCOM_USART_INT_INTFLAG_RXS_Msk) != 0U);
+        testCondition = ((SERCOM5_REGS->USART_INT.SERCOM_INTENSET & SERCOM_USART_INT_INTENSET_RXS_Msk) != 0U) && testCondition;
+        if(testCondition)
+        {
+            SERCOM5_USART_ISR_RXS_Handler();
+        }
+
         /* Checks for receive complete empty flag */
         testCondition = ((SERCOM5_REGS->USART_INT.SERCOM_INTFLAG & SERCOM_USART_INT_INTFLAG_RXC_Msk) != 0U);
         testCondition = ((SERCOM5_REGS->USART_INT.SERCOM_INTENSET & SERCOM_USART_INT_INTENSET_RXC_Msk) != 0U) && testCondition;
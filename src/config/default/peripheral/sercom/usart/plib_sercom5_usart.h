@@ -90,12 +90,20 @@ size_t SERCOM5_USART_WriteFreeBufferCountGet(void);
 
 size_t SERCOM5_USART_WriteBufferSizeGet(void);
 
+uint32_t SERCOM5_USART_WriteSpanGet(SERCOM_USART_SPAN spans[2]);
+
+void SERCOM5_USART_WriteCommit(size_t size);
+
 bool SERCOM5_USART_WriteNotificationEnable(bool isEnabled, bool isPersistent);
 
 void SERCOM5_USART_WriteThresholdSet(uint32_t nBytesThreshold);
 
 void SERCOM5_USART_WriteCallbackRegister( SERCOM_USART_RING_BUFFER_CALLBACK callback, uintptr_t context);
 
+void SERCOM5_USART_TxDmaEnable(bool isEnabled);
+
+bool SERCOM5_USART_TxDmaIsEnabled(void);
+
 
 
 size_t SERCOM5_USART_Read(uint8_t* pRdBuffer, const size_t size);
@@ -112,6 +120,16 @@ void SERCOM5_USART_ReadThresholdSet(uint32_t nBytesThreshold);
 
 void SERCOM5_USART_ReadCallbackRegister( SERCOM_USART_RING_BUFFER_CALLBACK callback, uintptr_t context);
 
+bool SERCOM5_USART_RxDmaEnable(bool isEnabled);
+
+bool SERCOM5_USART_RxDmaIsEnabled(void);
+
+void SERCOM5_USART_StatsGet(SERCOM_USART_STATS* pStats);
+
+void SERCOM5_USART_StatsReset(void);
+
+size_t SERCOM5_USART_RingBenchmark(SERCOM_USART_RING_OP op, uint8_t* pBuffer, const size_t size);
+
 // DOM-IGNORE-BEGIN
 #ifdef __cplusplus  // Provide C++ Compatibility
 
@@ -393,6 +393,111 @@ typedef struct
 
 } SERCOM_USART_RING_BUFFER_OBJECT;
 
+// *****************************************************************************
+/* SERCOM USART Ring Buffer Span
+
+  Summary:
+    Contiguous region of a ring buffer.
+
+  Description:
+    The free space of a ring buffer is described by up to two spans, the
+    first from the write index to the end of the buffer, the second from
+    the start of the buffer. Used by the zero-copy write interface.
+
+  Remarks:
+    None.
+*/
+
+typedef struct
+{
+    uint8_t*                                            pData;
+
+    size_t                                              size;
+
+} SERCOM_USART_SPAN;
+
+// *****************************************************************************
+/* SERCOM USART Ring Buffer Operation
+
+  Summary:
+    Ring buffer operation timed by the ring buffer benchmark.
+
+  Description:
+    WRITE copies bytes into the write ring with the Write function, PULL takes
+    them out one at a time as the data register empty interrupt does, READ
+    copies bytes out of the read ring with the Read function.
+
+  Remarks:
+    None.
+*/
+
+typedef enum
+{
+    SERCOM_USART_RING_OP_WRITE = 0,
+
+    SERCOM_USART_RING_OP_PULL,
+
+    SERCOM_USART_RING_OP_READ,
+
+} SERCOM_USART_RING_OP;
+
+// *****************************************************************************
+/* SERCOM USART Statistics
+
+  Summary:
+    Interrupt and transfer counters of the USART ring buffer.
+
+  Description:
+    Counts interrupts, bytes and handler CPU cycles for the per-byte
+    interrupt transmitter and receiver and for their DMA counterparts, so
+    the two can be compared. Cycle counts are read from the DWT cycle counter, which the
+    application must enable.
+
+  Remarks:
+    None.
+*/
+
+typedef struct
+{
+    /* Data register empty interrupts that moved bytes with the CPU */
+    uint32_t                                            txIsrCount;
+
+    uint32_t                                            txIsrBytes;
+
+    uint32_t                                            txIsrCycles;
+
+    /* Interrupts taken on the DMA path (DMA start and block complete) */
+    uint32_t                                            txDmaIsrCount;
+
+    uint32_t                                            txDmaIsrCycles;
+
+    uint32_t                                            txDmaBytes;
+
+    uint32_t                                            txDmaBlocks;
+
+    uint32_t                                            txDmaErrors;
+
+    /* Receive complete interrupts that moved bytes with the CPU */
+    uint32_t                                            rxIsrCount;
+
+    uint32_t                                            rxIsrBytes;
+
+    uint32_t                                            rxIsrCycles;
+
+    /* Interrupts taken on the DMA path (start of frame and idle timer) */
+    uint32_t                                            rxDmaIsrCount;
+
+    uint32_t                                            rxDmaIsrCycles;
+
+    uint32_t                                            rxDmaBytes;
+
+    uint32_t                                            rxDmaOverruns;
+
+    /* Read threshold callbacks, i.e. reader wake ups */
+    uint32_t                                            rxNotifications;
+
+} SERCOM_USART_STATS;
+
 // *****************************************************************************
 // DOM-IGNORE-BEGIN
 #ifdef __cplusplus  // Provide C++ Compatibility
@@ -160,6 +160,12 @@ uint32_t SYSTICK_GetTickCounter(void)
     return systick.tickCounter;
 }
 
+/* Count ticks that passed while SysTick was stopped (tickless idle) */
+void SYSTICK_TickCounterAdd(uint32_t ticks)
+{
+    systick.tickCounter += ticks;
+}
+
 void SYSTICK_StartTimeOut (SYSTICK_TIMEOUT* timeout, uint32_t delay_ms)
 {
     timeout->start = SYSTICK_GetTickCounter();
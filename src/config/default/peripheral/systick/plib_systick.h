@@ -88,6 +88,7 @@ void SYSTICK_DelayUs ( uint32_t delay_us );
 
 void SYSTICK_TimerCallbackSet ( SYSTICK_CALLBACK callback, uintptr_t context );
 uint32_t SYSTICK_GetTickCounter(void);
+void SYSTICK_TickCounterAdd(uint32_t ticks);
 void SYSTICK_StartTimeOut (SYSTICK_TIMEOUT* timeout, uint32_t delay_ms);
 void SYSTICK_ResetTimeOut (SYSTICK_TIMEOUT* timeout);
 bool SYSTICK_IsTimeoutReached (SYSTICK_TIMEOUT* timeout);
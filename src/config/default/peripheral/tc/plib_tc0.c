@@ -62,6 +62,14 @@
 // *****************************************************************************
 // *****************************************************************************
 
+static volatile TC_TIMER_CALLBACK_OBJ TC0_CallbackObject;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
 
 // *****************************************************************************
 // *****************************************************************************
@@ -84,15 +92,16 @@ void TC0_TimerInitialize( void )
     /* Configure counter mode & prescaler */
     TC0_REGS->COUNT32.TC_CTRLA = TC_CTRLA_MODE_COUNT32 | TC_CTRLA_PRESCALER_DIV1 | TC_CTRLA_PRESCSYNC_PRESC ;
 
-    /* Configure in Match Frequency Mode */
-    TC0_REGS->COUNT32.TC_WAVE = (uint8_t)TC_WAVE_WAVEGEN_MPWM;
-
-    /* Configure timer period */
-    TC0_REGS->COUNT32.TC_CC[0U] = 0U;
+    /* Configure in Normal PWM Mode: TOP is the 32-bit maximum, CC0 and CC1 are compare values */
+    TC0_REGS->COUNT32.TC_WAVE = (uint8_t)TC_WAVE_WAVEGEN_NPWM;
 
     /* Clear all interrupt flags */
     TC0_REGS->COUNT32.TC_INTFLAG = (uint8_t)TC_INTFLAG_Msk;
 
+    TC0_CallbackObject.callback = NULL;
+
+    /* Enable interrupt*/
+    TC0_REGS->COUNT32.TC_INTENSET = (uint8_t)(TC_INTENSET_OVF_Msk);
 
 
     while((TC0_REGS->COUNT32.TC_SYNCBUSY) != 0U)
@@ -167,7 +176,7 @@ void TC0_Timer32bitCounterSet( uint32_t count )
     }
 }
 
-/* Configure timer period */
+/* Configure timer period (CC0, a compare value in NPWM mode) */
 void TC0_Timer32bitPeriodSet( uint32_t period )
 {
     TC0_REGS->COUNT32.TC_CC[0] = period;
@@ -183,13 +192,39 @@ uint32_t TC0_Timer32bitPeriodGet( void )
     return TC0_REGS->COUNT32.TC_CC[0];
 }
 
+/* Configure timer compare value */
+void TC0_Timer32bitCompareSet( uint32_t compare )
+{
+    TC0_REGS->COUNT32.TC_CC[1] = compare;
+    while((TC0_REGS->COUNT32.TC_SYNCBUSY & TC_SYNCBUSY_CC1_Msk) == TC_SYNCBUSY_CC1_Msk)
+    {
+        /* Wait for Write Synchronization */
+    }
+}
+
+
 
+/* Register callback function */
+void TC0_TimerCallbackRegister( TC_TIMER_CALLBACK callback, uintptr_t context )
+{
+    TC0_CallbackObject.callback = callback;
+
+    TC0_CallbackObject.context = context;
+}
 
-/* Polling method to check if timer period interrupt flag is set */
-bool TC0_TimerPeriodHasExpired( void )
+/* Timer Interrupt handler */
+void __attribute__((used)) TC0_TimerInterruptHandler( void )
 {
-    uint8_t timer_status = 0U;
-    timer_status = (uint8_t)((TC0_REGS->COUNT32.TC_INTFLAG) & TC_INTFLAG_OVF_Msk);
-    TC0_REGS->COUNT32.TC_INTFLAG = timer_status;
-    return (timer_status != 0U);
+    if (TC0_REGS->COUNT32.TC_INTENSET != 0U)
+    {
+        TC_TIMER_STATUS status;
+        status = (TC_TIMER_STATUS) TC0_REGS->COUNT32.TC_INTFLAG;
+        /* Clear interrupt flags */
+        TC0_REGS->COUNT32.TC_INTFLAG = (uint8_t)TC_INTFLAG_Msk;
+        if((status != TC_TIMER_STATUS_NONE) && (TC0_CallbackObject.callback != NULL))
+        {
+            uintptr_t context = TC0_CallbackObject.context;
+            TC0_CallbackObject.callback(status, context);
+        }
+    }
 }
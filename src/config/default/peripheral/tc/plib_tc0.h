@@ -100,12 +100,14 @@ void TC0_Timer32bitPeriodSet( uint32_t period );
 
 uint32_t TC0_Timer32bitPeriodGet( void );
 
+void TC0_Timer32bitCompareSet( uint32_t compare );
+
 uint32_t TC0_Timer32bitCounterGet( void );
 
 void TC0_Timer32bitCounterSet( uint32_t count );
 
 
-bool TC0_TimerPeriodHasExpired( void );
+void TC0_TimerCallbackRegister( TC_TIMER_CALLBACK callback, uintptr_t context );
 
 void TC0_TimerCommandSet(TC_COMMAND command);
 
@@ -0,0 +1,15 @@
+// crc.h
+//
+// CRC32 (IEEE 802.3, same as zlib) using the DSU CRC engine, with a software fallback
+
+#ifndef CRC_H
+#define CRC_H
+#include <stdint.h>
+#include <stdbool.h>
+
+void crc_init(void);
+uint32_t crc32(const void *data, uint32_t len);
+uint32_t crc32_sw(const void *data, uint32_t len);
+bool crc32_hw(const void *data, uint32_t len, uint32_t *crc);
+
+#endif // CRC_H
@@ -0,0 +1,144 @@
+/**************************************************************************************************
+job.c
+Background commands
+
+A command that may take a while is written as a step function that does a little work and returns
+JOB_RUNNING, or JOB_DONE when it has finished.  Its command handler just calls job_run().  Typed
+on its own, the command runs in the foreground: job_run() calls the step function until it is
+done, running due scheduler tasks (and other jobs) in between.  With a trailing "&" word the
+command returns at once and the step function runs as a scheduler task every period_ms, so the
+command line stays responsive; "[n] Done" is printed when it finishes.
+
+Step functions are usually written as stackless coroutines with JOB_BEGIN(), JOB_YIELD() and
+JOB_END() (see job.h), keeping their state in job->data.  The command's context is copied into
+the job (job->ctx), as the caller's line buffer is reused by the next command line.
+
+"jobs" lists the background jobs, "kill <n>" stops one.
+
+**************************************************************************************************/
+
+#include <string.h>
+
+#include "job.h"
+#include "definitions.h"                // SYS function prototypes
+#include "command_line.h"
+#include "logger.h"
+#include "scheduler.h"
+
+static JOB jobs[JOB_MAX_JOBS];
+
+static int cl_jobs(CL_CONTEXT *ctx);
+static int cl_kill(CL_CONTEXT *ctx);
+
+static const CL_ARG kill_args[] = {
+    {"job",       CL_ARG_INT,     1, JOB_MAX_JOBS, NULL},
+    {NULL},
+};
+
+static const COMMAND_ITEM job_cmd_table[] = {
+    {"jobs",      "list background commands, start one with \"<command> &\"", cl_jobs},
+    {"kill",      "stop a background command, \"kill <job>\"",              cl_kill, kill_args},
+    {NULL,NULL,NULL}, /* end of table */
+};
+
+void job_init(void) {
+    cl_register(job_cmd_table);
+}
+
+static int job_number(const JOB *job) {
+    return (int)(job - jobs) + 1;
+}
+
+static void job_free(JOB *job) {
+    if (job->task_id >= 0) sched_task_cancel(job->task_id);
+    job->step = NULL;
+}
+
+// Scheduler task running a background job
+static void job_task(uintptr_t context) {
+    JOB *job = (JOB *)context;
+    job->steps++;
+    if (job->step(job) == JOB_DONE) {
+        log_msg("[%d] Done %s, %lu ms\n", job_number(job), job->name,
+                SYSTICK_GetTickCounter() - job->start_ms);
+        job_free(job);
+    }
+}
+
+// Run the command that called us (ctx) as a job.  With "&" (ctx->background) it runs as a
+// scheduler task every period_ms and job_run() returns at once, otherwise job_run() returns when
+// it is done.  Return 0, or 1 if there is no free job or task slot.
+int job_run(CL_CONTEXT *ctx, const char *name, JOB_STEP_FN step, uint32_t period_ms) {
+    bool background = ctx->background;
+    JOB *job = NULL;
+
+    ctx->background = false;    // taken
+    for (int i = 0; i < JOB_MAX_JOBS; i++) {
+        if (jobs[i].step == NULL) {
+            job = &jobs[i];
+            break;
+        }
+    }
+    if (job == NULL) {
+        log_msg("No free job slot for \"%s\"\n", name);
+        return 1;
+    }
+
+    memset(job, 0, sizeof(*job));
+    job->ctx = *ctx;
+    job->ctx.output = NULL;     // background output goes to the console
+    for (int i = 0; i < ctx->argc; i++) {
+        job->ctx.argv[i] = &job->ctx.buffer[ctx->argv[i] - ctx->buffer];
+    }
+    for (int i = 0; ctx->command->args && ctx->command->args[i].name; i++) {
+        if (ctx->command->args[i].type == CL_ARG_STR && i + 1 < ctx->argc) {
+            job->ctx.args[i].s = job->ctx.argv[i + 1];
+        }
+    }
+    job->name = name;
+    job->step = step;
+    job->task_id = -1;
+    job->start_ms = SYSTICK_GetTickCounter();
+
+    if (background) {
+        job->task_id = sched_task_create(name, job_task, (uintptr_t)job, SCHED_PRIORITY_LOW, 0U, period_ms);
+        if (job->task_id < 0) {
+            job->step = NULL;
+            return 1;
+        }
+        log_msg("[%d] %s\n", job_number(job), name);
+        return 0;
+    }
+
+    for (;;) {
+        job->steps++;
+        if (job->step(job) == JOB_DONE) break;
+        sched_run();
+    }
+    job_free(job);
+    return 0;
+}
+
+static int cl_jobs(CL_CONTEXT *ctx) {
+    log_msg("Job Name         Steps  Time ms Command\n");
+    for (int i = 0; i < JOB_MAX_JOBS; i++) {
+        JOB *job = &jobs[i];
+        if (job->step == NULL || job->task_id < 0) continue;
+        log_msg("%3d %-12s %6lu %8lu", job_number(job), job->name, job->steps,
+                SYSTICK_GetTickCounter() - job->start_ms);
+        for (int a = 0; a < job->ctx.argc; a++) log_msg(" %s", job->ctx.argv[a]);
+        log_msg("\n");
+    }
+    return 0;
+}
+
+static int cl_kill(CL_CONTEXT *ctx) {
+    int n = (int)ctx->args[0].i;
+    if (jobs[n - 1].step == NULL || jobs[n - 1].task_id < 0) {
+        log_msg("No background job %d\n", n);
+        return 1;
+    }
+    log_msg("[%d] Killed %s\n", n, jobs[n - 1].name);
+    job_free(&jobs[n - 1]);
+    return 0;
+}
@@ -0,0 +1,42 @@
+// job.h
+//
+// Background commands ("command &"), run as scheduler tasks, see job.c
+
+#ifndef JOB_H
+#define JOB_H
+#include <stdint.h>
+#include <stdbool.h>
+#include "command_line.h"
+
+#define JOB_MAX_JOBS    4   // jobs running at once, background and foreground
+#define JOB_DATA_WORDS  8   // step function state kept between steps
+
+typedef enum {
+    JOB_DONE,
+    JOB_RUNNING,
+} JOB_STATUS;
+
+typedef struct JOB JOB;
+typedef JOB_STATUS (*JOB_STEP_FN)(JOB *job);
+
+struct JOB {
+    const char *    name;
+    JOB_STEP_FN     step;                   // NULL for a free slot
+    int             task_id;                // scheduler task, -1 in the foreground
+    uint16_t        resume;                 // JOB_YIELD() resume point, 0 to start
+    uint32_t        start_ms;
+    uint32_t        steps;
+    CL_CONTEXT      ctx;                    // copy of the command's context: argc, argv[], args[]
+    uint32_t        data[JOB_DATA_WORDS];   // step function state, zero at the start
+};
+
+// Stackless coroutine for a step function.  Locals don't survive JOB_YIELD(), keep state in
+// job->data.  JOB_YIELD() can't be used in a switch statement.
+#define JOB_BEGIN(job)  switch ((job)->resume) { case 0:
+#define JOB_YIELD(job)  do { (job)->resume = __LINE__; return JOB_RUNNING; case __LINE__:; } while (0)
+#define JOB_END(job)    } return JOB_DONE
+
+void job_init(void);
+int job_run(CL_CONTEXT *ctx, const char *name, JOB_STEP_FN step, uint32_t period_ms);
+
+#endif // JOB_H
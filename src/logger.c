@@ -8,9 +8,46 @@ A single 128 byte stack buffer, "buf_compose", is used to compose a message
 If the FIFO can't hold the entire message, drop the message and increment "dropped_messages" counter.
 Return number of characters written to FIFO
 
-Additional Features: When message is displayed in UART console:
-Log message begins with millisecond timestamp using xTaskGetTickCount()
-All log messages get an automatic "Line Feed"
+Timestamps: deferred and dictionary records carry the 64-bit microsecond time they were logged at
+(timebase.c), so they never wrap and show when something happened, not when it was formatted.
+
+Deferred logging: log_defer() / LOG_DEFER() only store the format string pointer and up to
+LOG_DEFER_MAX_ARGS raw 32-bit argument words into a ring of records.  The vsnprintf() formatting
+is done later by a low priority scheduler task, keeping it out of the caller's hot path.  Each
+line is prefixed with its timestamp, "[seconds.microseconds] ".
+The format string must remain valid (string literal), and arguments must be 32-bit integers,
+characters or pointers (%d %u %x %c %s %p) - no floating point or 64-bit values.
+
+Dictionary logging: LOG_DICT() goes one step further, the format string isn't even in the
+device.  It is placed in the .log_fmt linker section (not loaded), and its address in that
+section is the format-string ID.  Only a binary record is sent through the SERCOM5 TX FIFO,
+interleaved with normal text output:
+    LOG_DICT_SYNC, varint (ID << 3 | argument count), timestamp (low 32 bits of the us time),
+    arguments (varint each)
+A varint is 7 bits per byte, low bits first, the top bit set on all but the last byte.  The
+timestamp is little-endian; tools/log_decode.py extends it to 64 bits by counting wraps, which it
+can as long as records are less than 71 minutes apart.  It rebuilds the text using the ELF file.
+A record is 7 bytes (8 in tools/sim, where IDs are larger) plus one per small argument, up to
+5 for a pointer or a large or negative value, against 13 bytes of "[seconds.microseconds] "
+prefix alone in the text.  "logdict"'s messages come out 3-4x smaller, more for long format
+strings, less for messages made mostly of 32-bit hex values; the 5-10x hoped for would need the
+timestamp to shrink too.  It stays absolute rather than a delta from the previous record:
+producers in interrupt handlers reserve log_ring space in a different order than they read the
+time, so a delta could be taken from the wrong record.
+
+Interrupt safety: all output goes through "log_ring", a lock-free multi-producer / single-consumer
+byte ring, so log_msg(), LOG_DEFER() and LOG_DICT() may be called from interrupt handlers as
+well as the main loop without disabling interrupts.  A producer reserves space with LDREX/STREX,
+copies its message in, then commits.  The reservation word also counts the producers that are
+still copying.  Interrupts nest, so the first producer in is always the last one out, and when
+the count drops to zero every reserved byte has been written and can be published to the
+consumer.  log_flush() (main loop only) moves published bytes into the SERCOM5 TX FIFO, so
+SERCOM5_USART_Write() is never re-entered from an interrupt.
+
+The "log_flush" task is one-shot, not polled: LOG_DEFER() and interrupt handlers writing to
+log_ring trigger it, and when the TX FIFO is too full to take everything, a write threshold
+notification triggers it again once LOG_FLUSH_THRESHOLD bytes are free.  An idle core isn't woken
+for it.
 
 **************************************************************************************************/
 
@@ -26,16 +63,266 @@ All log messages get an automatic "Line Feed"
 
 #include "logger.h"
 #include "command_line.h" // ANSI colors
+#include "scheduler.h"
+#include "bench.h"
+#include "timebase.h"
+#include "swtimer.h"
 
 #define PRINTF_BUF_SIZE             128
+#define LOG_DEFER_RECORDS           64      // power of two
+#define LOG_FLUSH_THRESHOLD         256     // TX FIFO bytes free before a blocked flush retries
+#define LOG_RING_SIZE               2048    // power of two, no larger than 65536
 
 volatile uint32_t dropped_messages = 0;
 
-// print to a buffer, write buffer to SERCOM5
+// Multi-producer byte ring.  Positions are free running 16-bit counts, index is count & (LOG_RING_SIZE - 1)
+static uint8_t log_ring[LOG_RING_SIZE];
+static volatile uint32_t log_claim;     // bits 0-15: reserved head, bits 16-31: producers still copying
+static volatile uint32_t log_commit;    // published head, bytes before this may be sent
+static volatile uint32_t log_tail;      // consumer position, only written by log_flush()
+#define LOG_CLAIM_WRITER            0x10000U
+
+// Output capture (rpc.c): while capture_buf is set, log_msg() from the main loop appends to it
+// instead of log_ring.  Interrupt handler output is not captured.
+static char *capture_buf;
+static uint32_t capture_size;
+static uint32_t capture_len;
+
+// Deferred log record - format string pointer plus raw argument words
+typedef struct {
+    const char *    fmt;
+    uint64_t        timestamp;      // timebase_us()
+    uint32_t        nargs;
+    uintptr_t       args[LOG_DEFER_MAX_ARGS];
+} LOG_DEFER_RECORD;
+
+_Static_assert(LOG_NARGS(1, 2, 3, 4) == LOG_DEFER_MAX_ARGS, "LOG_NARGS() counts to 4, see logger.h");
+
+// A record is filled in once its slot is reserved, and published by setting fmt (last).
+// The consumer clears fmt after formatting the record.
+static LOG_DEFER_RECORD defer_ring[LOG_DEFER_RECORDS];
+static volatile uint32_t defer_in;      // free running counts, index is count & (LOG_DEFER_RECORDS - 1)
+static volatile uint32_t defer_out;
+
+static int cl_logger_test(CL_CONTEXT *ctx);
+static int cl_logbench(CL_CONTEXT *ctx);
+static int cl_logdict(CL_CONTEXT *ctx);
+static int cl_logstress(CL_CONTEXT *ctx);
+static void log_flush_task(uintptr_t context);
+static void log_tx_callback(SERCOM_USART_EVENT event, uintptr_t context);
+static int flush_task_id = -1;
+static void bench_log_msg(void);
+static void bench_log_defer(void);
+static void bench_ring_setup(void);
+static void bench_log_ring(void);
+
+static const COMMAND_ITEM logger_cmd_table[] = {
+    {"logger",    "Log message test",                                       cl_logger_test},
+    {"logbench",  "log latency - log_msg() vs deferred formatting",         cl_logbench},
+    {"logdict",   "dictionary log test - send binary log records",          cl_logdict},
+    {"logstress", "log from SysTick ISR and main loop at the same time",    cl_logstress},
+    {NULL,NULL,NULL}, /* end of table */
+};
+
+static const BENCH_CASE logger_bench_table[] = {
+    {"log_msg",     "log_msg() with 3 arguments, formatting only",  NULL,               bench_log_msg},
+    {"log_defer",   "LOG_DEFER() and formatting the record",        NULL,               bench_log_defer},
+    {"log_ring",    "16 byte log_ring push and pull",               bench_ring_setup,   bench_log_ring},
+    {NULL,NULL,NULL,NULL}, /* end of table */
+};
+
+// Register the logger commands and benchmark cases, create the flush / deferred formatting task
+// (one-shot, it runs once now for anything logged before this, then when triggered)
+void logger_init(void) {
+    cl_register(logger_cmd_table);
+    bench_register(logger_bench_table);
+    SERCOM5_USART_WriteThresholdSet(LOG_FLUSH_THRESHOLD);
+    SERCOM5_USART_WriteCallbackRegister(log_tx_callback, 0U);
+    flush_task_id = sched_task_create("log_flush", log_flush_task, 0U, SCHED_PRIORITY_LOW, 0U, 0U);
+}
+
+static inline bool log_in_isr(void) {
+    return __get_IPSR() != 0U;
+}
+
+// Count a dropped message, callers may be interrupt handlers
+static void log_dropped(void) {
+    uint32_t count;
+    do {
+        count = __LDREXW((uint32_t *)&dropped_messages);
+    } while (__STREXW(count + 1U, (uint32_t *)&dropped_messages));
+}
+
+// Copy up to size published log_ring bytes to dest, and free them.  Return the number copied.
+// Single consumer - only called from the main loop, never from an interrupt handler.
+static uint32_t log_ring_read(uint8_t *dest, uint32_t size) {
+    uint32_t tail = log_tail;
+    uint32_t pending = (log_commit - tail) & 0xFFFFU;
+    uint32_t total = 0;
+
+    if (pending > size) pending = size;
+    while (pending) {
+        uint32_t index = tail & (LOG_RING_SIZE - 1);
+        uint32_t chunk = LOG_RING_SIZE - index;     // contiguous bytes before log_ring wraps
+        if (chunk > pending) chunk = pending;
+        memcpy(dest, &log_ring[index], chunk);
+        dest += chunk;
+        pending -= chunk;
+        total += chunk;
+        tail = (tail + chunk) & 0xFFFFU;
+    }
+    log_tail = tail;
+    return total;
+}
+
+// Move published log_ring bytes into the SERCOM5 TX FIFO, as many as fit.  Copies straight into
+// the TX FIFO's free space with memcpy() (at most two spans on each side of the copy).
+// Single consumer - only called from the main loop, never from an interrupt handler.
+void log_flush(void) {
+    SERCOM_USART_SPAN spans[2];
+    uint32_t nspans = (log_commit != log_tail) ? SERCOM5_USART_WriteSpanGet(spans) : 0U;
+    uint32_t total = 0;
+
+    for (uint32_t i = 0; i < nspans; i++) {
+        uint32_t count = log_ring_read(spans[i].pData, spans[i].size);
+        total += count;
+        if (count < spans[i].size) break;
+    }
+    if (total) SERCOM5_USART_WriteCommit(total);
+
+    // Bytes left behind: flush again once the TX FIFO has room, checking the room after enabling
+    // the notification in case it drained meanwhile
+    if (log_commit != log_tail) {
+        (void)SERCOM5_USART_WriteNotificationEnable(true, true);
+        if (SERCOM5_USART_WriteFreeBufferCountGet() >= LOG_FLUSH_THRESHOLD) {
+            (void)SERCOM5_USART_WriteNotificationEnable(false, false);
+            sched_task_trigger(flush_task_id);
+        }
+    }
+}
+
+// TX FIFO write threshold reached (interrupt handler): stop the notification, and flush
+static void log_tx_callback(SERCOM_USART_EVENT event, uintptr_t context) {
+    (void)context;
+    if (event == SERCOM_USART_EVENT_WRITE_THRESHOLD_REACHED) {
+        (void)SERCOM5_USART_WriteNotificationEnable(false, false);
+        sched_task_trigger(flush_task_id);
+    }
+}
+
+// True when nothing is reserved or waiting in log_ring
+static inline bool log_ring_empty(void) {
+    return log_claim == log_tail;
+}
+
+// Copy len bytes into log_ring.  Lock-free, safe from any interrupt level.
+// Return len, or 0 if there was no room (message dropped).
+static int log_ring_write(const void *data, uint32_t len) {
+    uint32_t claim;
+    uint32_t head;
+
+    // Reserve len bytes and count ourselves as a producer
+    do {
+        claim = __LDREXW((uint32_t *)&log_claim);
+        head = claim & 0xFFFFU;
+        if (((head - log_tail) & 0xFFFFU) + len > LOG_RING_SIZE) {
+            __CLREX();
+            log_dropped();
+            return 0;
+        }
+    } while (__STREXW(((claim + LOG_CLAIM_WRITER) & 0xFFFF0000U) | ((head + len) & 0xFFFFU), (uint32_t *)&log_claim));
+
+    // Copy the message, in two parts if it wraps around the end of the ring
+    uint32_t index = head & (LOG_RING_SIZE - 1);
+    uint32_t first = LOG_RING_SIZE - index;
+    if (first > len) first = len;
+    memcpy(&log_ring[index], data, first);
+    memcpy(log_ring, (const uint8_t *)data + first, len - first);
+    __DMB();
+
+    // Commit.  The last producer out publishes everything reserved so far.
+    do {
+        claim = __LDREXW((uint32_t *)&log_claim);
+    } while (__STREXW(claim - LOG_CLAIM_WRITER, (uint32_t *)&log_claim));
+    if ((claim - LOG_CLAIM_WRITER) < LOG_CLAIM_WRITER) {
+        // Publish the reserved head, never moving log_commit backwards in case a nested
+        // producer published a later head after our commit
+        uint32_t publish = claim & 0xFFFFU;
+        uint32_t commit;
+        do {
+            commit = __LDREXW((uint32_t *)&log_commit);
+            if ((int16_t)(publish - commit) <= 0) {
+                __CLREX();
+                break;
+            }
+        } while (__STREXW(publish, (uint32_t *)&log_commit));
+    }
+    return (int)len;
+}
+
+// Queue len bytes for output.  Return len, or 0 if dropped.
+static int log_write(const void *data, uint32_t len) {
+    int ret = log_ring_write(data, len);
+    if (!log_in_isr()) {
+        log_flush(); // main loop sends the message right away
+    } else if (ret) {
+        sched_task_trigger(flush_task_id);
+    }
+    return ret;
+}
+
+// Send raw bytes (binary frames) through log_ring, interleaved with text output.
+// Return len, or 0 if dropped.
+int log_bytes(const void *data, uint32_t len) {
+    return log_write(data, len);
+}
+
+// Capture main loop log_msg() output in buf (NUL terminated, truncated to size - 1 characters)
+// until log_capture_stop(), which returns the captured length
+void log_capture_start(char *buf, uint32_t size) {
+    buf[0] = 0;
+    capture_len = 0;
+    capture_size = size;
+    capture_buf = buf;
+}
+
+uint32_t log_capture_stop(void) {
+    capture_buf = NULL;
+    return capture_len;
+}
+
+// print to a buffer, write buffer to SERCOM5 (through log_ring)
+// Fast path: from the main loop, with nothing queued in log_ring, vsnprintf() formats straight
+// into the SERCOM5 TX FIFO, avoiding the print_buf copy.
 int log_msg(const char *fmt, ...) {
     char print_buf[PRINTF_BUF_SIZE];
-    // Format user message
     va_list args;
+
+    if (capture_buf && !log_in_isr()) {
+        uint32_t space = capture_size - capture_len;
+        va_start(args, fmt);
+        int msg_len = vsnprintf(&capture_buf[capture_len], space, fmt, args);
+        va_end(args);
+        if (msg_len < 0) return 0;
+        if ((uint32_t)msg_len >= space) msg_len = (int)space - 1;
+        capture_len += (uint32_t)msg_len;
+        return msg_len;
+    }
+
+    if (!log_in_isr() && log_ring_empty()) {
+        SERCOM_USART_SPAN spans[2];
+        if (SERCOM5_USART_WriteSpanGet(spans) && spans[0].size >= PRINTF_BUF_SIZE) {
+            va_start(args, fmt);
+            int msg_len = vsnprintf((char *)spans[0].pData, PRINTF_BUF_SIZE, fmt, args);
+            va_end(args);
+            if (msg_len < 0) return 0; // Error creating message
+            if (msg_len >= PRINTF_BUF_SIZE) msg_len = PRINTF_BUF_SIZE-1; // same truncation as print_buf
+            SERCOM5_USART_WriteCommit((size_t)msg_len);
+            return msg_len;
+        }
+    }
+
+    // Format user message
     va_start(args, fmt);
     int msg_len = vsnprintf(print_buf, PRINTF_BUF_SIZE, fmt, args);
     va_end(args);
@@ -46,18 +333,104 @@ int log_msg(const char *fmt, ...) {
     // If message is too long, but we have it in the buffer, use it
     if (msg_len >= PRINTF_BUF_SIZE) msg_len = PRINTF_BUF_SIZE-1; // always a null on the end
     
-    // How much space is available in TX ring buffer?
-    uint32_t tx_space_available = SERCOM5_USART_WriteFreeBufferCountGet();
-    if(tx_space_available >= (uint32_t)msg_len) {
-        // Enough space in ring buffer...
-        SERCOM5_USART_Write((uint8_t *)print_buf, msg_len);
-        return msg_len;
+    return log_write(print_buf, (uint32_t)msg_len);
+}
+
+// Queue a format string pointer and nargs raw argument words, format them later.
+// Use the LOG_DEFER() macro, which fills in nargs.  Return 1 if queued, 0 if the ring was full.
+// Safe from interrupt handlers: the slot is reserved with LDREX/STREX.
+int log_defer(const char *fmt, uint32_t nargs, ...) {
+    uint32_t in;
+    do {
+        in = __LDREXW((uint32_t *)&defer_in);
+        if (in - defer_out >= LOG_DEFER_RECORDS) {
+            __CLREX();
+            log_dropped();
+            return 0;
+        }
+    } while (__STREXW(in + 1U, (uint32_t *)&defer_in));
+    LOG_DEFER_RECORD *rec = &defer_ring[in & (LOG_DEFER_RECORDS - 1)];
+    rec->timestamp = timebase_us();
+    if (nargs > LOG_DEFER_MAX_ARGS) nargs = LOG_DEFER_MAX_ARGS;
+    va_list args;
+    va_start(args, nargs);
+    for (uint32_t i = 0; i < nargs; i++) {
+        rec->args[i] = va_arg(args, uintptr_t);
     }
-    dropped_messages++;
-    return 0;
+    va_end(args);
+    rec->nargs = nargs;
+    __DMB();
+    rec->fmt = fmt; // publish the record
+    sched_task_trigger(flush_task_id);
+    return 1;
+}
+
+// Store value as a varint at dest, return its length (1 to 5 bytes)
+static uint32_t log_varint(uint8_t *dest, uint32_t value) {
+    uint32_t len = 0;
+    while (value >= 0x80U) {
+        dest[len++] = (uint8_t)(value | 0x80U);
+        value >>= 7;
+    }
+    dest[len++] = (uint8_t)value;
+    return len;
+}
+
+// Send a dictionary log record.  Use the LOG_DICT() macro, which places the format string in the
+// .log_fmt section and fills in fmt_id and nargs.  Return record length, or 0 if dropped.
+int log_dict(uint32_t fmt_id, uint32_t nargs, ...) {
+    uint8_t record[1 + 3 + 4 + (5 * LOG_DEFER_MAX_ARGS)];
+    uint32_t timestamp = (uint32_t)timebase_us();
+    if (nargs > LOG_DEFER_MAX_ARGS) nargs = LOG_DEFER_MAX_ARGS;
+
+    record[0] = LOG_DICT_SYNC;
+    uint32_t len = 1U + log_varint(&record[1], ((fmt_id & 0xFFFFU) << 3) | nargs);
+    memcpy(&record[len], &timestamp, sizeof(timestamp)); // Cortex-M is little-endian
+    len += sizeof(timestamp);
+    va_list args;
+    va_start(args, nargs);
+    for (uint32_t i = 0; i < nargs; i++) {
+        len += log_varint(&record[len], (uint32_t)va_arg(args, uintptr_t));
+    }
+    va_end(args);
+
+    return log_write(record, len);
+}
+
+// Format and output all queued deferred records.  Return number of records written.
+// Main loop only.  Stops at a reserved record that its producer hasn't finished filling in.
+// Each line goes out as one message, so an interrupt handler can't log between its timestamp and
+// its text; lines are truncated to PRINTF_BUF_SIZE - 1 characters, as log_msg() does.
+uint32_t log_defer_flush(void) {
+    char line[PRINTF_BUF_SIZE];
+    uint32_t count = 0;
+    while (defer_out != defer_in) {
+        LOG_DEFER_RECORD *rec = &defer_ring[defer_out & (LOG_DEFER_RECORDS - 1)];
+        const char *fmt = rec->fmt;
+        if (fmt == NULL) break; // not published yet
+        uint32_t seconds;
+        uint32_t micros;
+        timebase_split(rec->timestamp, &seconds, &micros);
+        int len = snprintf(line, sizeof(line), "[%lu.%06lu] ", (unsigned long)seconds, (unsigned long)micros);
+        // Unused argument words are passed but ignored by the format string
+        snprintf(&line[len], sizeof(line) - (uint32_t)len, fmt, rec->args[0], rec->args[1], rec->args[2], rec->args[3]);
+        log_msg("%s", line);
+        rec->fmt = NULL;
+        __DMB();
+        defer_out++;
+        count++;
+    }
+    return count;
+}
+
+// Format deferred records, and send anything interrupt handlers have logged
+static void log_flush_task(uintptr_t context) {
+    (void)context;
+    log_defer_flush();
+    log_flush();
 }
 
-int cl_logger_test(void) {
+static int cl_logger_test(CL_CONTEXT *ctx) {
     uint32_t start_us;
     uint32_t stop_us;
 	// Measure time to push out some long log messages
@@ -83,3 +456,120 @@ int cl_logger_test(void) {
 	return 0;
 }
 
+
+// Compare the caller's cost of a formatted log message: log_msg() formats immediately,
+// LOG_DEFER() only queues the format pointer and arguments.
+#define LOGBENCH_MESSAGES 32
+static int cl_logbench(CL_CONTEXT *ctx) {
+    uint32_t start_us;
+    uint32_t direct_us;
+    uint32_t defer_us;
+
+    log_defer_flush(); // start with an empty deferred ring
+
+    start_us = TC0_Timer32bitCounterGet();
+    for (int i = 0; i < LOGBENCH_MESSAGES; i++) {
+        log_msg("msg %d, value 0x%08X, %s\n", i, 0xDEADBEEFU + i, "direct");
+    }
+    direct_us = TC0_Timer32bitCounterGet() - start_us;
+
+    start_us = TC0_Timer32bitCounterGet();
+    for (int i = 0; i < LOGBENCH_MESSAGES; i++) {
+        LOG_DEFER("msg %d, value 0x%08X, %s\n", i, 0xDEADBEEFU + i, "deferred");
+    }
+    defer_us = TC0_Timer32bitCounterGet() - start_us;
+
+    start_us = TC0_Timer32bitCounterGet();
+    log_defer_flush();
+    uint32_t flush_us = TC0_Timer32bitCounterGet() - start_us;
+
+    // Per message times in tenths of a microsecond
+    uint32_t direct = (direct_us * 10U) / LOGBENCH_MESSAGES;
+    uint32_t defer = (defer_us * 10U) / LOGBENCH_MESSAGES;
+    log_msg("\n%d messages\n", LOGBENCH_MESSAGES);
+    log_msg("log_msg():   %lu.%lu us/message\n", direct / 10U, direct % 10U);
+    log_msg("LOG_DEFER(): %lu.%lu us/message (formatted later in %lu us)\n", defer / 10U, defer % 10U, flush_us);
+    return 0;
+}
+
+// Send a few dictionary log records, to be decoded by tools/log_decode.py
+static int cl_logdict(CL_CONTEXT *ctx) {
+    uint32_t bytes = 0;
+    bytes += LOG_DICT("Dictionary log test\n");
+    for (int i = 0; i < 3; i++) {
+        bytes += LOG_DICT("record %d of %d, value 0x%08X\n", i + 1, 3, 0xDEADBEEFU + i);
+    }
+    bytes += LOG_DICT("%s, %c\n", "string arguments are read from the ELF", 'c');
+    log_msg("dictionary records: %lu bytes\n", bytes);
+    log_msg("dropped messages: %lu\n", dropped_messages);
+    return 0;
+}
+
+// Log from the SysTick interrupt (a 1ms SWTIMER_ISR timer) while the main loop logs too, LOGSTRESS_MS long.
+// The main loop also formats the ISR's deferred records as they come.  Every line should arrive
+// intact, "dropped" counts messages that found log_ring or the deferred ring full;
+// tools/sim/log_stress.py checks both.
+#define LOGSTRESS_MS 200
+static volatile uint32_t stress_isr_count;
+static SWTIMER stress_timer;
+
+static void logstress_tick(uintptr_t context) {
+    (void)context;
+    log_msg("isr %lu\n", stress_isr_count);
+    LOG_DEFER("isr deferred %lu\n", stress_isr_count);
+    stress_isr_count++;
+}
+
+static int cl_logstress(CL_CONTEXT *ctx) {
+    uint32_t dropped_start = dropped_messages;
+    uint32_t thread_count = 0;
+    SYSTICK_TIMEOUT timeout;
+
+    stress_isr_count = 0;
+    SYSTICK_StartTimeOut(&timeout, LOGSTRESS_MS);
+    swtimer_start(&stress_timer, 1U, 1U, logstress_tick, 0U, SWTIMER_ISR);
+    while (!SYSTICK_IsTimeoutReached(&timeout)) {
+        log_msg("main loop message %lu\n", thread_count);
+        thread_count++;
+        log_defer_flush();
+    }
+    swtimer_cancel(&stress_timer);
+    // Let log_ring drain before and after formatting the deferred records, so neither they nor
+    // the summary are dropped for want of room
+    while (!log_ring_empty()) log_flush();
+    log_defer_flush();
+    while (!log_ring_empty()) log_flush();
+    log_msg("\nISR messages: %lu, main loop messages: %lu, dropped: %lu\n",
+            stress_isr_count * 2U, thread_count, dropped_messages - dropped_start);
+    return 0;
+}
+
+//=================================================================================================
+// Benchmark cases (bench.c).  The bench runner captures log_msg() output, so only the formatting
+// is timed, not the UART.
+//=================================================================================================
+static uint8_t bench_bytes[16];
+
+static void bench_log_msg(void) {
+    log_msg("msg %d, value 0x%08X, %s\n", 42, 0xDEADBEEFU, "bench");
+}
+
+// Queue a deferred record and format it
+static void bench_log_defer(void) {
+    LOG_DEFER("msg %d, value 0x%08X, %s\n", 42, 0xDEADBEEFU, "bench");
+    log_defer_flush();
+}
+
+// Wait for log_ring to drain, so the ring case starts with it empty
+static void bench_ring_setup(void) {
+    while (!log_ring_empty()) {
+        log_flush();
+    }
+}
+
+// Push 16 bytes into log_ring and pull them out again.  Anything an interrupt handler logs
+// meanwhile is pulled out with them and lost.
+static void bench_log_ring(void) {
+    log_ring_write(bench_bytes, sizeof(bench_bytes));
+    log_ring_read(bench_bytes, sizeof(bench_bytes));
+}
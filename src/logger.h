@@ -4,7 +4,43 @@
 #define LOGGER_H
 #include "stdint.h"
 
+#define LOG_DEFER_MAX_ARGS  4   // maximum argument words per deferred message
+
+void logger_init(void);
 int log_msg(const char *fmt, ...);
+int log_defer(const char *fmt, uint32_t nargs, ...);
+uint32_t log_defer_flush(void);
+void log_flush(void);
+int log_bytes(const void *data, uint32_t len);
+void log_capture_start(char *buf, uint32_t size);
+uint32_t log_capture_stop(void);
+
+// Count 0 to LOG_DEFER_MAX_ARGS macro arguments.  5 to 12 arguments land on LOG_TOO_MANY_ARGS,
+// which stops the build, rather than the 5th argument being taken as the count.
+#define LOG_NARGS(...)  LOG_NARGS_(0, ##__VA_ARGS__, LOG_TOO_MANY_ARGS, LOG_TOO_MANY_ARGS, \
+        LOG_TOO_MANY_ARGS, LOG_TOO_MANY_ARGS, LOG_TOO_MANY_ARGS, LOG_TOO_MANY_ARGS, \
+        LOG_TOO_MANY_ARGS, LOG_TOO_MANY_ARGS, 4, 3, 2, 1, 0)
+#define LOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, N, ...) N
+#define LOG_TOO_MANY_ARGS   sizeof(struct { int x; _Static_assert(0, \
+        "LOG_DEFER() and LOG_DICT() take at most LOG_DEFER_MAX_ARGS arguments"); })
+
+// Deferred log message: LOG_DEFER("value %d\n", value);  Arguments are stored as raw 32-bit words,
+// see logger.c for the supported conversions
+#define LOG_DEFER(fmt, ...) log_defer(fmt, LOG_NARGS(__VA_ARGS__), ##__VA_ARGS__)
+
+// Dictionary log message: LOG_DICT("value %d\n", value);  The format string is placed in the
+// .log_fmt linker section, which is not loaded into the device.  Only a compact binary record
+// (string ID, 32-bit us timestamp, varint arguments) is sent; tools/log_decode.py rebuilds the text
+// from the ELF file.  Same argument rules as LOG_DEFER().  Its value is the record length, 0 if
+// dropped.
+#define LOG_DICT(fmt, ...) ({ \
+        static const char log_dict_fmt[] __attribute__((section(".log_fmt"), used)) = fmt; \
+        log_dict((uint32_t)(uintptr_t)log_dict_fmt, LOG_NARGS(__VA_ARGS__), ##__VA_ARGS__); \
+    })
+
+#define LOG_DICT_SYNC       0x1E    // ASCII record separator, starts each dictionary record
+
+int log_dict(uint32_t fmt_id, uint32_t nargs, ...);
 extern volatile uint32_t dropped_messages;
 
 #endif // LOGGER_H
@@ -29,6 +29,16 @@
 #include <stdint.h>
 #include "definitions.h"                // SYS function prototypes
 #include "command_line.h"
+#include "logger.h"
+#include "scheduler.h"
+#include "uart.h"
+#include "rpc.h"
+#include "crc.h"
+#include "job.h"
+#include "bench.h"
+#include "timebase.h"
+#include "swtimer.h"
+#include "power.h"
 
 // Implement a getchar function, needed for Command Line
 // If character available, return character, else return EOF
@@ -41,6 +51,43 @@ int __io_getchar(void) {
     } else return EOF;
 } // __io_getchar())
 
+// Main loop event flags.  Set from interrupt context, read and cleared by the main loop
+#define EVENT_UART_RX   (1U << 0)       // SERCOM5 received one or more characters
+static volatile uint32_t main_events;
+
+// SERCOM5 read notification - called from the SERCOM5 ISR for each received character, or with the
+// RX DMA from the TC2 poll that finds new characters (two character times after the first one of a
+// burst, then every millisecond)
+static void uart_read_callback(SERCOM_USART_EVENT event, uintptr_t context) {
+    (void)context;
+    if (event == SERCOM_USART_EVENT_READ_THRESHOLD_REACHED) {
+        main_events |= EVENT_UART_RX;
+    }
+}
+
+// Toggle the user LED, showing the main loop is alive
+static void heartbeat_task(uintptr_t context) {
+    (void)context;
+    LED_AL_PA14_Toggle();
+}
+
+// Sleep until an interrupt posts an event or a scheduler task is due, then return (and clear)
+// the pending events.
+// Interrupts are disabled while checking the flags, so an event posted between the check
+// and the WFI can't be missed; WFI still wakes on a pending interrupt with PRIMASK set.
+static uint32_t wait_for_events(void) {
+    __disable_irq();
+    while (main_events == 0U && !sched_ready()) {
+        power_sleep();  // sleep, SysTick (or TC0 when tickless) and SERCOM5 interrupts wake us
+        __enable_irq(); // let the pending interrupt run
+        __disable_irq();
+    }
+    uint32_t events = main_events;
+    main_events = 0U;
+    __enable_irq();
+    return events;
+}
+
 
 
 // *****************************************************************************
@@ -55,25 +102,45 @@ int main ( void )
     SYS_Initialize ( NULL );
     SYSTICK_TimerStart();
     //-------------------------------------------------------
-    // Before we start TC0, reconfigure the period
     /* TC0 is configured within the clock configurator to use GCLK2 (1 MHz) */
-    /* Configure TC0 timer period */
-    TC0_REGS->COUNT32.TC_CC[0U] = 0xFFFFFFFFU;
+    /* It counts the full 32 bits (NPWM, TOP is the maximum), CC0 is power.c's wakeup */
     /* Clear all interrupt flags */
     TC0_REGS->COUNT32.TC_INTFLAG = (uint8_t)TC_INTFLAG_Msk;
     while((TC0_REGS->COUNT32.TC_SYNCBUSY) != 0U)
     { /* Wait for Write Synchronization */ }
     TC0_TimerStart(); // microsecond counter
     
-    // Initialize Command Line
+    // Initialize Command Line, then let each module register its commands
     cl_setup();
+    timebase_init();
+    scheduler_init();
+    swtimer_init();
+    power_init();
+    logger_init();
+    uart_init();
+    rpc_init();
+    crc_init();
+    job_init();
+    bench_init();
+    sched_task_create("heartbeat", heartbeat_task, 0U, SCHED_PRIORITY_LOW, 0U, 500U);
+
+    // Have the SERCOM5 RX ISR notify us whenever at least one character is waiting
+    SERCOM5_USART_ReadCallbackRegister(uart_read_callback, 0U);
+    SERCOM5_USART_ReadThresholdSet(1U);
+    SERCOM5_USART_ReadNotificationEnable(true, true);
 
     while ( true )
     {
         /* Maintain state machines of all polled MPLAB Harmony modules. */
         //SYS_Tasks ( ); // No tasks at this time
-        cl_loop();              // Check for character, if available, process it
-        SYSTICK_DelayMs(50);    // Slow things down a bit
+        uint32_t events = wait_for_events(); // sleep until something happens
+        if (events & EVENT_UART_RX) {
+            // cl_loop() returns after each line, keep calling it until the RX ring is empty
+            do {
+                cl_loop();
+            } while (SERCOM5_USART_ReadCountGet());
+        }
+        sched_run();    // run any background tasks that are due
     }
 
     /* Execution should not come here during normal operation */
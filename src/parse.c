@@ -0,0 +1,124 @@
+/**************************************************************************************************
+parse.c
+Number parsing for command arguments
+
+Smaller and faster replacements for strtol() and strtof() when converting command arguments: no
+locale, no errno, no octal, and the whole string must be a number, so "12abc" is an error rather
+than 12.  Both return false for a string that isn't a number or is out of range.
+
+parse_int()     [+|-] decimal digits, or [+|-] 0x hex digits.  Decimal values must fit an int32_t;
+                hex values may use all 32 bits (0x80000000 to 0xFFFFFFFF come back negative), as
+                addresses and register values are usually given in hex.
+parse_float()   [+|-] digits [. digits] [e|E [+|-] digits], at least one digit before the
+                exponent.  The first 9 significant digits are kept in a uint32_t, then scaled by
+                a power of ten, so the result is within an ulp or two of strtof().
+
+The module uses only the C library headers, so tools/parse_bench.c builds it on a PC to compare
+it against strtol() and strtof().
+
+**************************************************************************************************/
+
+#include <float.h>
+
+#include "parse.h"
+
+static bool parse_hex(const char *s, uint32_t *value) {
+    uint32_t v = 0;
+    if (*s == 0) return false;
+    for (; *s; s++) {
+        uint32_t digit;
+        if (*s >= '0' && *s <= '9') digit = (uint32_t)(*s - '0');
+        else if (*s >= 'a' && *s <= 'f') digit = (uint32_t)(*s - 'a' + 10);
+        else if (*s >= 'A' && *s <= 'F') digit = (uint32_t)(*s - 'A' + 10);
+        else return false;
+        if (v > 0x0FFFFFFFU) return false;  // more than 8 significant digits
+        v = (v << 4) | digit;
+    }
+    *value = v;
+    return true;
+}
+
+static bool parse_dec(const char *s, uint32_t *value) {
+    uint32_t v = 0;
+    if (*s == 0) return false;
+    for (; *s; s++) {
+        if (*s < '0' || *s > '9') return false;
+        uint32_t digit = (uint32_t)(*s - '0');
+        if (v > (0xFFFFFFFFU - digit) / 10U) return false;
+        v = v * 10U + digit;
+    }
+    *value = v;
+    return true;
+}
+
+bool parse_int(const char *s, int32_t *value) {
+    bool negative = (*s == '-');
+    uint32_t v;
+    if (*s == '-' || *s == '+') s++;
+    if (s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) {
+        if (!parse_hex(&s[2], &v)) return false;
+        if (negative && v > 0x80000000U) return false;
+    } else {
+        if (!parse_dec(s, &v)) return false;
+        if (v > (negative ? 0x80000000U : 0x7FFFFFFFU)) return false;
+    }
+    *value = (int32_t)(negative ? 0U - v : v);
+    return true;
+}
+
+bool parse_float(const char *s, float *value) {
+    static const float pow10[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+    bool negative = (*s == '-');
+    uint32_t mantissa = 0;
+    int digits = 0;         // significant digits in mantissa
+    int exponent = 0;       // decimal exponent of mantissa
+    bool any = false;
+
+    if (*s == '-' || *s == '+') s++;
+    for (; *s >= '0' && *s <= '9'; s++) {
+        any = true;
+        if (digits < 9) {
+            mantissa = mantissa * 10U + (uint32_t)(*s - '0');
+            if (mantissa) digits++;
+        } else {
+            exponent++;     // digit dropped
+        }
+    }
+    if (*s == '.') {
+        for (s++; *s >= '0' && *s <= '9'; s++) {
+            any = true;
+            if (digits < 9) {
+                mantissa = mantissa * 10U + (uint32_t)(*s - '0');
+                if (mantissa) digits++;
+                exponent--;
+            }
+        }
+    }
+    if (!any) return false;
+    if (*s == 'e' || *s == 'E') {
+        bool exp_negative = (s[1] == '-');
+        int e = 0;
+        s += (s[1] == '-' || s[1] == '+') ? 2 : 1;
+        if (*s < '0' || *s > '9') return false;
+        for (; *s >= '0' && *s <= '9'; s++) {
+            if (e < 1000) e = e * 10 + (*s - '0');
+        }
+        exponent += exp_negative ? -e : e;
+    }
+    if (*s) return false;
+
+    float f = (float)mantissa;
+    if (mantissa) {
+        if (exponent > 2 * FLT_MAX_10_EXP || exponent < 2 * FLT_MIN_10_EXP - 10) {
+            f = (exponent > 0) ? FLT_MAX * 2.0f : 0.0f;
+        } else {
+            for (; exponent >= 10; exponent -= 10) f *= pow10[10];
+            for (; exponent <= -10; exponent += 10) f /= pow10[10];
+            if (exponent > 0) f *= pow10[exponent];
+            else if (exponent < 0) f /= pow10[-exponent];
+        }
+    }
+    if (f > FLT_MAX) return false;  // out of range
+    *value = negative ? -f : f;
+    return true;
+}
@@ -0,0 +1,13 @@
+// parse.h
+//
+// Number parsing for command arguments, no locale and no errno, see parse.c
+
+#ifndef PARSE_H
+#define PARSE_H
+#include <stdint.h>
+#include <stdbool.h>
+
+bool parse_int(const char *s, int32_t *value);
+bool parse_float(const char *s, float *value);
+
+#endif // PARSE_H
@@ -0,0 +1,177 @@
+/**************************************************************************************************
+power.c
+Tickless idle
+
+The main loop sleeps in power_sleep() when it has nothing to do.  With the 1 ms SysTick running,
+the core wakes 1000 times a second just to count the tick.  In tickless mode (the default),
+power_sleep() instead finds the next tick with work to do - the next software timer expiry or
+cascade (swtimer.c) and the next scheduler task due - and if that is at least POWER_MIN_TICKS
+away, turns the SysTick interrupt off, sets a TC0 compare match (CC0) for the start of that tick,
+and sleeps until the match or any other interrupt.
+
+SysTick keeps counting meanwhile, so the tick boundaries stay where they were.  power_init()
+anchors the tick count to a tick boundary in TC0 time; on waking, TC0 and the SysTick count give
+the number of reloads since the anchor, so the ticks the count is behind are exact whatever the
+sleep.  They are added to the tick count, the last one by pending the SysTick interrupt so its
+handler runs the timer wheel at once.  Apart from the missing wakeups, the tick count, timers and
+tasks see no difference, and the tick count doesn't drift from TC0.
+
+"power" shows wakeups per second and the idle percentage since the last "power" command, and how
+far the tick count is from TC0 time; "power tick" and "power tickless" switch modes, to compare
+the two.
+
+**************************************************************************************************/
+
+#include <string.h>
+
+#include "power.h"
+#include "definitions.h"                // SYS function prototypes
+#include "command_line.h"
+#include "logger.h"
+#include "scheduler.h"
+#include "swtimer.h"
+#include "timebase.h"
+
+#define POWER_MIN_TICKS     2U          // shortest tickless sleep, otherwise sleep with the tick
+#define POWER_MAX_TICKS     10000U      // longest tickless sleep
+#define CYCLES_PER_US       (CPU_CLOCK_FREQUENCY / 1000000U)
+#define POWER_GUARD_CYCLES  (50U * CYCLES_PER_US)   // margin from a reload, generous for tools/sim
+
+static bool tickless = true;
+
+// Statistics since the last "power" command
+static uint64_t stats_start_us;
+static uint32_t wakeups;
+static uint32_t tickless_sleeps;
+static uint64_t idle_us;
+static uint32_t longest_ms;
+static uint32_t tick_offset;            // TC0 milliseconds - tick count, at power_init()
+
+// A tick boundary in CPU cycles of TC0 time, and the tick count it began
+static uint64_t anchor_cycles;
+static uint32_t anchor_tick;
+
+static int cl_power(CL_CONTEXT *ctx);
+
+static const CL_ARG power_args[] = {
+    {"mode",       CL_ARG_STR,     0, 0,                 ""},
+    {NULL},
+};
+
+static const COMMAND_ITEM power_cmd_table[] = {
+    {"power",     "idle statistics, \"power [tick|tickless]\" to change mode", cl_power, power_args},
+    {NULL,NULL,NULL}, /* end of table */
+};
+
+// Wait until the SysTick count is at least POWER_GUARD_CYCLES from its next reload
+static inline void power_tick_guard(void) {
+    while (SysTick->VAL < POWER_GUARD_CYCLES) {
+    }
+}
+
+// Cycle of TC0 time at which the current tick began.  Call clear of a reload.
+static uint64_t power_tick_boundary(uint32_t period) {
+    uint32_t into_tick = period - 1U - SysTick->VAL;
+    return timebase_us() * CYCLES_PER_US - into_tick;
+}
+
+void power_init(void) {
+    uint32_t period = (SysTick->LOAD & SysTick_LOAD_RELOAD_Msk) + 1U;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    power_tick_guard();
+    anchor_cycles = power_tick_boundary(period);
+    anchor_tick = SYSTICK_GetTickCounter() + ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) ? 1U : 0U);
+    __set_PRIMASK(primask);
+
+    stats_start_us = timebase_us();
+    tick_offset = (uint32_t)(stats_start_us / 1000U) - SYSTICK_GetTickCounter();
+    cl_register(power_cmd_table);
+}
+
+// Sleep with the tick interrupt off until the start of tick "ticks" from now, or an earlier
+// interrupt
+static void power_sleep_tickless(uint32_t ticks) {
+    uint32_t period = (SysTick->LOAD & SysTick_LOAD_RELOAD_Msk) + 1U;   // cycles per tick
+
+    // The tick interrupt goes off and back on clear of a reload, so each tick is either pended
+    // or counted on waking, never both
+    power_tick_guard();
+    SysTick->CTRL &= ~SysTick_CTRL_TICKINT_Msk;
+    uint32_t into_tick = period - 1U - SysTick->VAL;                    // cycles
+    uint32_t start = TC0_Timer32bitCounterGet();
+
+    TC0_REGS->COUNT32.TC_CC[0U] = start + (ticks * period - into_tick) / CYCLES_PER_US;
+    while ((TC0_REGS->COUNT32.TC_SYNCBUSY & TC_SYNCBUSY_CC0_Msk) == TC_SYNCBUSY_CC0_Msk)
+    { /* Wait for Write Synchronization */ }
+    TC0_REGS->COUNT32.TC_INTFLAG = (uint8_t)TC_INTFLAG_MC0_Msk;
+    TC0_REGS->COUNT32.TC_INTENSET = (uint8_t)TC_INTENSET_MC0_Msk;
+
+    __WFI();    // the compare match, or an earlier interrupt
+
+    TC0_REGS->COUNT32.TC_INTENCLR = (uint8_t)TC_INTENCLR_MC0_Msk;
+    power_tick_guard();
+    uint64_t boundary = power_tick_boundary(period);
+    SysTick->CTRL |= SysTick_CTRL_TICKINT_Msk;
+
+    // Reloads since the anchor, rounded so a late sample can't lose one.  A tick pended before
+    // the sleep is among them, and its handler counts it; the last one otherwise.
+    uint32_t reloads = (uint32_t)((boundary - anchor_cycles + period / 2U) / period);
+    int32_t behind = (int32_t)(anchor_tick + reloads - SYSTICK_GetTickCounter());
+    if (behind > 0) {
+        SYSTICK_TickCounterAdd((uint32_t)behind - 1U);
+        SCB->ICSR = SCB_ICSR_PENDSTSET_Msk;     // the handler counts the last one, runs the wheel
+    }
+
+    uint32_t slept = TC0_Timer32bitCounterGet() - start;
+    tickless_sleeps++;
+    if (slept / 1000U > longest_ms) longest_ms = slept / 1000U;
+}
+
+// Sleep until an interrupt.  Called with interrupts disabled, returns with them still disabled,
+// so the interrupt runs once the caller enables them.
+void power_sleep(void) {
+    uint32_t now = SYSTICK_GetTickCounter();
+    uint32_t next = now + POWER_MAX_TICKS;
+    uint32_t due;
+
+    if (swtimer_next_expiry(&due) && (int32_t)(due - next) < 0) next = due;
+    if (sched_next_due(&due) && (int32_t)(due - next) < 0) next = due;
+
+    uint32_t start = TC0_Timer32bitCounterGet();
+    if (tickless && (int32_t)(next - now) >= (int32_t)POWER_MIN_TICKS) {
+        power_sleep_tickless(next - now);
+    } else {
+        __WFI();
+    }
+    idle_us += TC0_Timer32bitCounterGet() - start;
+    wakeups++;
+}
+
+static int cl_power(CL_CONTEXT *ctx) {
+    const char *mode = ctx->args[0].s;
+    uint64_t elapsed_us = timebase_us() - stats_start_us;
+
+    if (mode[0] != '\0' && strcmp(mode, "tick") != 0 && strcmp(mode, "tickless") != 0) {
+        log_msg("Unknown mode \"%s\", use tick or tickless\n", mode);
+        return -1;
+    }
+    if (elapsed_us == 0U) elapsed_us = 1U;
+    // Tenths of a wakeup per second and of a percent
+    uint32_t rate = (uint32_t)((uint64_t)wakeups * 10000000U / elapsed_us);
+    uint32_t idle = (uint32_t)(idle_us * 1000U / elapsed_us);
+    log_msg("%s idle over %lu ms: %lu.%lu wakeups/s, %lu.%lu%% idle\n", tickless ? "Tickless" : "Tick",
+            (uint32_t)(elapsed_us / 1000U), rate / 10U, rate % 10U, idle / 10U, idle % 10U);
+    log_msg("Tickless sleeps: %lu, longest %lu ms\n", tickless_sleeps, longest_ms);
+    int32_t drift = (int32_t)(SYSTICK_GetTickCounter() + tick_offset - (uint32_t)(timebase_us() / 1000U));
+    log_msg("Tick count against TC0: %ld ms\n", (long)drift);
+
+    if (mode[0] != '\0') {
+        tickless = (strcmp(mode, "tickless") == 0);
+        log_msg("Now %s idle\n", tickless ? "tickless" : "tick");
+    }
+    stats_start_us = timebase_us();
+    idle_us = 0;
+    wakeups = tickless_sleeps = longest_ms = 0;
+    return (int)rate;
+}
@@ -0,0 +1,11 @@
+// power.h
+//
+// Tickless idle: sleep with the SysTick tick stopped until the next timer or task, see power.c
+
+#ifndef POWER_H
+#define POWER_H
+
+void power_init(void);
+void power_sleep(void);
+
+#endif // POWER_H
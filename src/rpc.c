@@ -0,0 +1,303 @@
+/**************************************************************************************************
+rpc.c
+Framed binary RPC on the command line UART
+
+Test rigs call the same command handlers as the text command line, without scraping text.  A frame
+is a 0x00 byte, the COBS encoded payload plus its CRC32, and another 0x00 byte.  A terminal never
+sends 0x00, so cl_loop() hands every byte to rpc_receive() first and a 0x00 switches to frame
+mode until the closing 0x00; everything else is text as before.
+
+A stray 0x00 (line noise, a terminal's Ctrl-@) must not swallow the console, so frame mode also
+ends, and the byte that ends it is text again, when:
+    - no byte has arrived for RPC_RX_TIMEOUT_MS (the host sends a frame in one write)
+    - a CR or LF follows three or more printable characters.  That is a typed line, not a
+      request: a request whose first COBS code byte is printable has a block of 31 or more
+      bytes, so its fourth byte is an argument tag (0x01 or 0x02).  Shorter blocks have a code
+      byte below 0x20.
+    - a CR or LF follows a COBS code byte pointing past the longest frame, or a frame that was
+      too long
+
+Payload, all values little-endian:
+    request:  sequence (8-bit), command ID (8-bit), arguments
+    response: sequence (8-bit), status (8-bit), values
+Arguments and values are typed, each starting with a tag byte:
+    RPC_TYPE_INT    int32 (4 bytes)
+    RPC_TYPE_STR    length (8-bit), characters (no terminator)
+The CRC32 (IEEE 802.3, as zlib) of the payload follows it, 4 bytes.
+
+Command ID N is the Nth command in name order (the sorted command index).  A call runs the handler
+in the RPC context (its own CL_CONTEXT, leaving the console's line alone) with argv[] built from
+the arguments (integers in decimal), and answers with the handler's return value (INT) and
+everything it printed with log_msg() (STR, truncated to RPC_MAX_OUTPUT bytes).
+Two IDs are reserved:
+    RPC_ID_LIST     argument INT first ID, answers STR command names from that ID on, as many
+                    as fit in a frame
+    RPC_ID_ECHO     answers with its arguments, for loopback tests
+Frames with a bad CRC are dropped and counted, there is no response.  tools/rpc_client.py is the
+host side.  "rpc" shows the frame counters.
+
+**************************************************************************************************/
+
+#include <string.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "rpc.h"
+#include "command_line.h"
+#include "logger.h"
+#include "crc.h"
+#include "timebase.h"
+
+#define RPC_MAX_PAYLOAD     250     // largest payload, excluding the CRC
+#define RPC_MAX_OUTPUT      200     // handler text returned by a call
+#define RPC_FRAME_SIZE      (RPC_MAX_PAYLOAD + 4 + ((RPC_MAX_PAYLOAD + 4) / 254) + 1)   // COBS encoded
+#define RPC_RX_TIMEOUT_MS   100     // longest gap between two bytes of a frame
+
+#define RPC_TYPE_INT        0x01
+#define RPC_TYPE_STR        0x02
+
+#define RPC_ID_LIST         0xFF
+#define RPC_ID_ECHO         0xFE
+
+#define RPC_STATUS_OK           0
+#define RPC_STATUS_UNKNOWN      1   // no command with this ID
+#define RPC_STATUS_BAD_ARGS     2   // malformed or too many arguments
+
+typedef enum {
+    RPC_RX_IDLE,                    // text, waiting for an opening 0x00
+    RPC_RX_FRAME,                   // between the opening and closing 0x00
+    RPC_RX_DISCARD,                 // not a valid frame, dropping bytes up to the closing 0x00
+} RPC_RX_STATE;
+
+static uint8_t rx_frame[RPC_FRAME_SIZE];
+static uint32_t rx_len;
+static uint32_t rx_code_pos;        // where the next COBS code byte is due
+static bool rx_text;                // every byte of the frame so far is a printable character
+static uint64_t rx_last_us;         // when the last byte arrived
+static RPC_RX_STATE rx_state;
+
+static uint32_t frames_ok;
+static uint32_t frames_crc_errors;
+static uint32_t frames_bad;         // too long, not valid COBS, or a typed line
+static uint32_t frames_timeout;     // no closing 0x00 within RPC_RX_TIMEOUT_MS of the last byte
+
+// Commands called over RPC get their own context, their output is returned in the response
+static CL_CONTEXT rpc_ctx;
+static char rpc_output[RPC_MAX_OUTPUT + 1];
+
+static int cl_rpc(CL_CONTEXT *ctx);
+
+static const COMMAND_ITEM rpc_cmd_table[] = {
+    {"rpc",       "binary RPC frame counters",                              cl_rpc},
+    {NULL,NULL,NULL}, /* end of table */
+};
+
+void rpc_init(void) {
+    cl_context_init(&rpc_ctx, rpc_output, sizeof(rpc_output));
+    cl_register(rpc_cmd_table);
+}
+
+// Decode a COBS frame in place.  Return the decoded length, or -1 if the frame is not valid COBS.
+static int cobs_decode(uint8_t *buf, uint32_t len) {
+    uint32_t in = 0;
+    uint32_t out = 0;
+    while (in < len) {
+        uint8_t code = buf[in++];
+        if (code == 0 || in + code - 1U > len) return -1;
+        for (uint8_t i = 1; i < code; i++) buf[out++] = buf[in++];
+        if (code < 0xFF && in < len) buf[out++] = 0;
+    }
+    return (int)out;
+}
+
+// COBS encode len bytes of data into out, which must hold len + len / 254 + 1 bytes.
+// Return the encoded length.
+static uint32_t cobs_encode(const uint8_t *data, uint32_t len, uint8_t *out) {
+    uint32_t code_pos = 0;
+    uint32_t out_len = 1;
+    uint8_t code = 1;
+    for (uint32_t i = 0; i < len; i++) {
+        if (data[i] == 0) {
+            out[code_pos] = code;
+            code_pos = out_len++;
+            code = 1;
+        } else {
+            out[out_len++] = data[i];
+            if (++code == 0xFF) {
+                out[code_pos] = code;
+                code_pos = out_len++;
+                code = 1;
+            }
+        }
+    }
+    out[code_pos] = code;
+    return out_len;
+}
+
+// Append the CRC, COBS encode and send a response payload of len bytes (room for 4 more)
+static void rpc_send(uint8_t *payload, uint32_t len) {
+    uint8_t frame[RPC_FRAME_SIZE + 2];
+    uint32_t crc = crc32(payload, len);
+    memcpy(&payload[len], &crc, sizeof(crc)); // Cortex-M is little-endian
+    frame[0] = 0;
+    uint32_t n = cobs_encode(payload, len + 4, &frame[1]);
+    frame[n + 1] = 0;
+    log_bytes(frame, n + 2);
+}
+
+// Append an INT value, return the new length
+static uint32_t put_int(uint8_t *p, uint32_t len, int32_t value) {
+    p[len] = RPC_TYPE_INT;
+    memcpy(&p[len + 1], &value, sizeof(value));
+    return len + 5;
+}
+
+// Append a STR value, return the new length
+static uint32_t put_str(uint8_t *p, uint32_t len, const char *s, uint32_t n) {
+    p[len] = RPC_TYPE_STR;
+    p[len + 1] = (uint8_t)n;
+    memcpy(&p[len + 2], s, n);
+    return len + 2 + n;
+}
+
+// Command names from the first ID on, as many as fit
+static uint32_t rpc_list(uint8_t *resp, uint32_t len, const uint8_t *args, uint32_t args_len) {
+    int32_t first = 0;
+    if (args_len >= 5 && args[0] == RPC_TYPE_INT) memcpy(&first, &args[1], sizeof(first));
+    for (const COMMAND_ITEM *cmd; (cmd = cl_command_at(first)) != NULL; first++) {
+        uint32_t n = strlen(cmd->command);
+        if (len + 2 + n > RPC_MAX_PAYLOAD) break;
+        len = put_str(resp, len, cmd->command, n);
+    }
+    return len;
+}
+
+// Build the RPC context's argv[] from the typed arguments and run the handler.  Return the
+// response length, or 0 if the arguments don't fit in argv[], are malformed, or don't match the
+// command's schema.
+static uint32_t rpc_call(const COMMAND_ITEM *cmd, uint8_t *resp, uint32_t len,
+                         const uint8_t *args, uint32_t args_len) {
+    char *arg_buf = rpc_ctx.buffer;
+    uint32_t used = 0;
+    uint32_t i = 0;
+    int n = snprintf(arg_buf, sizeof(rpc_ctx.buffer), "%s", cmd->command);
+
+    rpc_ctx.argc = 0;
+    rpc_ctx.argv[rpc_ctx.argc++] = arg_buf;
+    used = n + 1;
+    while (i < args_len) {
+        if (rpc_ctx.argc >= MAXWORDS) return 0;
+        if (args[i] == RPC_TYPE_INT && i + 5 <= args_len) {
+            int32_t value;
+            memcpy(&value, &args[i + 1], sizeof(value));
+            n = snprintf(&arg_buf[used], sizeof(rpc_ctx.buffer) - used, "%ld", (long)value);
+            i += 5;
+        } else if (args[i] == RPC_TYPE_STR && i + 2 <= args_len && i + 2 + args[i + 1] <= args_len) {
+            n = snprintf(&arg_buf[used], sizeof(rpc_ctx.buffer) - used, "%.*s", args[i + 1], (const char *)&args[i + 2]);
+            i += 2 + args[i + 1];
+        } else {
+            return 0;
+        }
+        if (n < 0 || used + n + 1 > sizeof(rpc_ctx.buffer)) return 0;
+        rpc_ctx.argv[rpc_ctx.argc++] = &arg_buf[used];
+        used += n + 1;
+    }
+
+    int ret;
+    if (!cl_call(&rpc_ctx, cmd, &ret)) return 0;
+    len = put_int(resp, len, ret);
+    return put_str(resp, len, rpc_output, rpc_ctx.output_len);
+}
+
+// Check and run one received frame
+static void rpc_process(uint8_t *frame, uint32_t frame_len) {
+    uint8_t resp[RPC_MAX_PAYLOAD + 4];
+    int len = cobs_decode(frame, frame_len);
+    if (len < 6 || len > RPC_MAX_PAYLOAD + 4) {
+        frames_bad++;
+        return;
+    }
+    uint32_t crc;
+    len -= 4;
+    memcpy(&crc, &frame[len], sizeof(crc));
+    if (crc != crc32(frame, (uint32_t)len)) {
+        frames_crc_errors++;
+        return;
+    }
+    frames_ok++;
+
+    uint8_t id = frame[1];
+    const uint8_t *args = &frame[2];
+    uint32_t args_len = (uint32_t)len - 2;
+    uint32_t resp_len = 0;
+
+    resp[0] = frame[0]; // sequence
+    resp[1] = RPC_STATUS_OK;
+    if (id == RPC_ID_LIST) {
+        resp_len = rpc_list(resp, 2, args, args_len);
+    } else if (id == RPC_ID_ECHO) {
+        memcpy(&resp[2], args, args_len);
+        resp_len = 2 + args_len;
+    } else {
+        const COMMAND_ITEM *cmd = cl_command_at(id);
+        if (cmd == NULL) {
+            resp[1] = RPC_STATUS_UNKNOWN;
+        } else {
+            resp_len = rpc_call(cmd, resp, 2, args, args_len);
+            if (resp_len == 0) resp[1] = RPC_STATUS_BAD_ARGS;
+        }
+    }
+    rpc_send(resp, resp_len ? resp_len : 2);
+}
+
+// Called by cl_loop() with each received character.  Return true if the character belongs to
+// a frame, false if it is command line text.
+bool rpc_receive(uint8_t c) {
+    uint64_t now = timebase_us();
+    bool line_end = (c == '\r' || c == '\n');
+
+    if (rx_state != RPC_RX_IDLE && now - rx_last_us > RPC_RX_TIMEOUT_MS * 1000U) {
+        frames_timeout++;
+        rx_state = RPC_RX_IDLE;
+    }
+    rx_last_us = now;
+
+    switch (rx_state) {
+        case RPC_RX_IDLE:
+            if (c != 0) return false;
+            rx_state = RPC_RX_FRAME;    // opening delimiter
+            rx_len = 0;
+            rx_code_pos = 0;
+            rx_text = true;
+            break;
+        case RPC_RX_FRAME:
+            if (c == 0) {
+                rx_state = RPC_RX_IDLE; // closing delimiter
+                if (rx_len) rpc_process(rx_frame, rx_len);
+            } else if (line_end && rx_text && rx_len >= 3) {
+                frames_bad++;           // a line typed after a stray 0x00
+                rx_state = RPC_RX_IDLE;
+                return false;
+            } else if (rx_len < sizeof(rx_frame) &&
+                       (rx_len != rx_code_pos || rx_len + c <= sizeof(rx_frame))) {
+                if (rx_len == rx_code_pos) rx_code_pos = rx_len + c;
+                if (c < ' ' || c > '~') rx_text = false;
+                rx_frame[rx_len++] = c;
+            } else {
+                frames_bad++;           // too long, or a code byte pointing past the longest frame
+                rx_state = line_end ? RPC_RX_IDLE : RPC_RX_DISCARD;
+                return !line_end;
+            }
+            break;
+        case RPC_RX_DISCARD:
+            if (c == 0 || line_end) rx_state = RPC_RX_IDLE;
+            return !line_end;
+    }
+    return true;
+}
+
+static int cl_rpc(CL_CONTEXT *ctx) {
+    log_msg("RPC frames: %lu ok, %lu CRC errors, %lu bad, %lu timed out\n",
+            frames_ok, frames_crc_errors, frames_bad, frames_timeout);
+    return 0;
+}
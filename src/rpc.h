@@ -0,0 +1,13 @@
+// rpc.h
+//
+// Framed binary RPC (COBS + CRC32) on the command line UART, see rpc.c
+
+#ifndef RPC_H
+#define RPC_H
+#include <stdint.h>
+#include <stdbool.h>
+
+void rpc_init(void);
+bool rpc_receive(uint8_t c);
+
+#endif // RPC_H
@@ -0,0 +1,178 @@
+/**************************************************************************************************
+scheduler.c
+Cooperative run-to-completion task scheduler
+
+Tasks are plain functions that run to completion from the main loop, never from interrupt context.
+Each task has a priority, a first-run delay, and a period (0 for a one-shot task).  When several
+tasks are due at once, the one with the lowest priority number runs first.  Due times use the
+SysTick 1ms tick counter, so a task that is due is run by the next pass through the main loop.
+
+Each task run is timed with the TC0 microsecond counter, giving per-task CPU usage, maximum run
+time, and an overrun count (task started a full period or more behind schedule).  Run time totals
+and the statistics window are 64-bit (timebase.c), so CPU usage stays right past the 71 minutes
+a 32-bit microsecond count wraps in.
+The "tasks" command displays the statistics, "tasks reset" clears them.
+
+**************************************************************************************************/
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "scheduler.h"
+#include "definitions.h"                // SYS function prototypes
+#include "command_line.h"
+#include "logger.h"
+#include "timebase.h"
+
+typedef struct {
+    const char *    name;
+    SCHED_TASK_FN   function;
+    uintptr_t       context;
+    uint8_t         priority;
+    bool            active;
+    uint32_t        period_ms;      // 0 for one-shot task
+    uint32_t        due_ms;         // SysTick tick count when the task should next run
+    // Accounting
+    uint32_t        runs;
+    uint32_t        overruns;       // started a full period (or more) late
+    uint64_t        total_us;       // run time since statistics were reset
+    uint32_t        max_us;         // longest single run
+} SCHED_TASK;
+
+static SCHED_TASK tasks[SCHED_MAX_TASKS];
+static uint64_t stats_start_us;     // timebase_us() when statistics were reset
+
+static int cl_tasks(CL_CONTEXT *ctx);
+
+static const COMMAND_ITEM sched_cmd_table[] = {
+    {"tasks",     "task statistics, \"tasks reset\" to clear",              cl_tasks},
+    {NULL,NULL,NULL}, /* end of table */
+};
+
+void scheduler_init(void) {
+    memset(tasks, 0, sizeof(tasks));
+    stats_start_us = timebase_us();
+    cl_register(sched_cmd_table);
+}
+
+// Add a task.  The task first runs after delay_ms, then every period_ms (0: run once).
+// Return task id, or -1 if all task slots are in use
+int sched_task_create(const char *name, SCHED_TASK_FN function, uintptr_t context,
+                      uint8_t priority, uint32_t delay_ms, uint32_t period_ms) {
+    for (int id = 0; id < SCHED_MAX_TASKS; id++) {
+        if (!tasks[id].active && tasks[id].function == NULL) {
+            SCHED_TASK *t = &tasks[id];
+            t->name = name;
+            t->function = function;
+            t->context = context;
+            t->priority = priority;
+            t->period_ms = period_ms;
+            t->due_ms = SYSTICK_GetTickCounter() + delay_ms;
+            t->runs = t->overruns = t->total_us = t->max_us = 0;
+            t->active = true;
+            return id;
+        }
+    }
+    log_msg("%s(), no free task slot for \"%s\"\n", __func__, name);
+    return -1;
+}
+
+// Remove a task, freeing its slot
+void sched_task_cancel(int task_id) {
+    if (task_id >= 0 && task_id < SCHED_MAX_TASKS) {
+        tasks[task_id].active = false;
+        tasks[task_id].function = NULL;
+    }
+}
+
+// Make a task due now (re-activating a completed one-shot task).  May be called from an
+// interrupt handler, as swtimer.c does.
+void sched_task_trigger(int task_id) {
+    if (task_id >= 0 && task_id < SCHED_MAX_TASKS && tasks[task_id].function) {
+        tasks[task_id].due_ms = SYSTICK_GetTickCounter();
+        tasks[task_id].active = true;
+    }
+}
+
+// Return true if a task is due.  Safe to call with interrupts disabled.
+bool sched_ready(void) {
+    uint32_t now = SYSTICK_GetTickCounter();
+    for (int id = 0; id < SCHED_MAX_TASKS; id++) {
+        if (tasks[id].active && (int32_t)(now - tasks[id].due_ms) >= 0) return true;
+    }
+    return false;
+}
+
+// The tick count when the next task is due, for tickless idle (power.c).  Return false if no
+// task is active.
+bool sched_next_due(uint32_t *due_ms) {
+    bool found = false;
+    for (int id = 0; id < SCHED_MAX_TASKS; id++) {
+        if (tasks[id].active && (!found || (int32_t)(tasks[id].due_ms - *due_ms) < 0)) {
+            *due_ms = tasks[id].due_ms;
+            found = true;
+        }
+    }
+    return found;
+}
+
+// Find the highest priority task that is due, or NULL
+static SCHED_TASK * sched_next(uint32_t now) {
+    SCHED_TASK *next = NULL;
+    for (int id = 0; id < SCHED_MAX_TASKS; id++) {
+        SCHED_TASK *t = &tasks[id];
+        if (t->active && (int32_t)(now - t->due_ms) >= 0) {
+            if (next == NULL || t->priority < next->priority) next = t;
+        }
+    }
+    return next;
+}
+
+// Run every task that is due, highest priority first.  Called from the main loop.
+void sched_run(void) {
+    SCHED_TASK *t;
+    while ((t = sched_next(SYSTICK_GetTickCounter())) != NULL) {
+        uint32_t now = SYSTICK_GetTickCounter();
+        if (t->period_ms) {
+            uint32_t late_ms = now - t->due_ms;
+            if (late_ms >= t->period_ms) {
+                // Missed one or more periods, skip them rather than running back to back
+                t->overruns++;
+                t->due_ms += (late_ms / t->period_ms) * t->period_ms;
+            }
+            t->due_ms += t->period_ms;
+        } else {
+            t->active = false; // one-shot
+        }
+
+        uint32_t start_us = TC0_Timer32bitCounterGet();
+        t->function(t->context);
+        uint32_t run_us = TC0_Timer32bitCounterGet() - start_us;
+
+        t->runs++;
+        t->total_us += run_us;
+        if (run_us > t->max_us) t->max_us = run_us;
+    }
+}
+
+static int cl_tasks(CL_CONTEXT *ctx) {
+    if (ctx->argc > 1 && strcmp(ctx->argv[1], "reset") == 0) {
+        for (int id = 0; id < SCHED_MAX_TASKS; id++) {
+            tasks[id].runs = tasks[id].overruns = tasks[id].total_us = tasks[id].max_us = 0;
+        }
+        stats_start_us = timebase_us();
+        return 0;
+    }
+    uint64_t elapsed_us = timebase_us() - stats_start_us;
+    log_msg("ID Name         Pri Period     Runs   CPU%%   Max us Overruns\n");
+    for (int id = 0; id < SCHED_MAX_TASKS; id++) {
+        SCHED_TASK *t = &tasks[id];
+        if (t->function == NULL) continue;
+        // CPU usage in hundredths of a percent
+        uint32_t cpu = elapsed_us ? (uint32_t)((t->total_us * 10000U) / elapsed_us) : 0;
+        log_msg("%2d %-12s %3u %6lu %8lu %3lu.%02lu %8lu %8lu\n", id, t->name, t->priority,
+                t->period_ms, t->runs, cpu / 100, cpu % 100, t->max_us, t->overruns);
+    }
+    log_msg("Statistics over %lu ms\n", (uint32_t)(elapsed_us / 1000U));
+    return 0;
+}
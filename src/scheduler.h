@@ -0,0 +1,25 @@
+// scheduler.h
+//
+// Cooperative run-to-completion task scheduler
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SCHED_MAX_TASKS     16  // number of task slots
+#define SCHED_PRIORITY_HIGH 0   // lower number runs first
+#define SCHED_PRIORITY_LOW  7
+
+typedef void (*SCHED_TASK_FN)(uintptr_t context);
+
+void scheduler_init(void);
+int sched_task_create(const char *name, SCHED_TASK_FN function, uintptr_t context,
+                      uint8_t priority, uint32_t delay_ms, uint32_t period_ms);
+void sched_task_cancel(int task_id);
+void sched_task_trigger(int task_id);
+bool sched_ready(void);
+bool sched_next_due(uint32_t *due_ms);
+void sched_run(void);
+
+#endif // SCHEDULER_H
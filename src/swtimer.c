@@ -0,0 +1,431 @@
+/**************************************************************************************************
+swtimer.c
+Software timers on a hierarchical timer wheel
+
+A timer is an SWTIMER owned by the caller, started with swtimer_start(timer, delay_ms, period_ms,
+function, context, flags) and stopped with swtimer_cancel().  When it expires its function is
+called from the SysTick interrupt (SWTIMER_ISR), or else from the main loop by the "swtimer"
+scheduler task.  Periodic timers keep their cadence; a main loop timer that falls a full period
+or more behind skips the periods it missed, as scheduler tasks do, and counts an overrun.
+
+The wheel owns the SysTick callback and is advanced every 1 ms tick.  Timers are kept in slots of
+doubly linked lists, by expiry tick:
+    level 0     256 slots of 1 ms           expiring in the next 256 ms
+    level 1     64 slots of 256 ms          the next 16.4 s
+    level 2     64 slots of 16.4 s          17.5 minutes
+    level 3     64 slots of 17.5 minutes    18.6 hours
+    level 4     64 slots of 18.6 hours      up to SWTIMER_MAX_MS (24.8 days)
+Each tick takes the whole level 0 slot for that tick, and every 256 ticks the next level 1 slot is
+cascaded: its timers are put back in by their expiry tick, now into level 0 (likewise level 2 into
+1 every 16.4 s, and so on).  Starting and cancelling a timer is a list insert or unlink, and each
+timer is cascaded at most 4 times, so their costs don't depend on how many timers there are.
+"timers bench" measures that, "timers" shows the counters.  swtimer_next_expiry() finds the next
+tick with work to do, so power.c can stop the tick until then.
+
+Interrupts are disabled while the lists are changed, so timers may be started and cancelled from
+the main loop, interrupt handlers and timer functions, including the function's own timer.
+
+**************************************************************************************************/
+
+#include <string.h>
+
+#include "swtimer.h"
+#include "definitions.h"                // SYS function prototypes
+#include "command_line.h"
+#include "logger.h"
+#include "scheduler.h"
+
+#define TV1_BITS            8
+#define TVN_BITS            6
+#define TV1_SIZE            (1U << TV1_BITS)
+#define TVN_SIZE            (1U << TVN_BITS)
+#define TVN_LEVELS          4           // levels above level 0
+#define SWTIMER_QUEUED      (1U << 31)  // flags: on the ready list, waiting for the main loop
+#define SWTIMER_BENCH_MAX   1024U       // most timers in "timers bench"
+#define SWTIMER_BENCH_SPAN  (1U << 18)  // "timers bench" delays, up to 262 s
+#define SWTIMER_BENCH_ROUNDS 3U
+
+typedef struct {
+    uint32_t        jiffies;            // next tick to process
+    SWTIMER *       tv1[TV1_SIZE];
+    SWTIMER *       tvn[TVN_LEVELS][TVN_SIZE];
+    uint32_t        pending;            // timers in the wheel
+    uint32_t        expired;
+    uint32_t        isr_calls;          // functions called while advancing, SWTIMER_ISR timers
+    uint32_t        cascaded;
+} WHEEL;
+
+static WHEEL wheel;
+static SWTIMER * ready;                 // expired main loop timers, oldest first
+static SWTIMER ** ready_tail = &ready;
+static int ready_task = -1;
+
+static uint32_t main_calls;
+static uint32_t overruns;
+static uint32_t max_tick_cycles;
+
+static int cl_timers(CL_CONTEXT *ctx);
+
+static const COMMAND_ITEM swtimer_cmd_table[] = {
+    {"timers",    "software timer wheel, \"timers bench\" to time it",      cl_timers},
+    {NULL,NULL,NULL}, /* end of table */
+};
+
+static inline uint32_t swtimer_lock(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+}
+
+static inline void swtimer_unlock(uint32_t primask) {
+    __set_PRIMASK(primask);
+}
+
+//=================================================================================================
+// Lists and the wheel, called with interrupts disabled
+//=================================================================================================
+
+static void timer_link(SWTIMER **head, SWTIMER *t) {
+    t->next = *head;
+    if (t->next) t->next->pprev = &t->next;
+    *head = t;
+    t->pprev = head;
+}
+
+static void timer_unlink(SWTIMER *t) {
+    if (ready_tail == &t->next) ready_tail = t->pprev;
+    *t->pprev = t->next;
+    if (t->next) t->next->pprev = t->pprev;
+    t->next = NULL;
+    t->pprev = NULL;
+}
+
+static void ready_append(SWTIMER *t) {
+    t->flags |= SWTIMER_QUEUED;
+    t->next = NULL;
+    t->pprev = ready_tail;
+    *ready_tail = t;
+    ready_tail = &t->next;
+}
+
+// Put a timer in the slot for its expiry tick
+static void wheel_add(WHEEL *w, SWTIMER *t) {
+    uint32_t delta = t->expires - w->jiffies;
+    SWTIMER **slot;
+
+    if ((int32_t)delta < 0) {
+        slot = &w->tv1[w->jiffies & (TV1_SIZE - 1U)];      // already due, the next tick
+    } else if (delta < TV1_SIZE) {
+        slot = &w->tv1[t->expires & (TV1_SIZE - 1U)];
+    } else {
+        int level = 0;
+        uint32_t shift = TV1_BITS;
+        while (level < TVN_LEVELS - 1 && delta >= (1U << (shift + TVN_BITS))) {
+            level++;
+            shift += TVN_BITS;
+        }
+        slot = &w->tvn[level][(t->expires >> shift) & (TVN_SIZE - 1U)];
+    }
+    timer_link(slot, t);
+}
+
+static void timer_remove(WHEEL *w, SWTIMER *t) {
+    if (t->flags & SWTIMER_QUEUED) t->flags &= ~SWTIMER_QUEUED;
+    else w->pending--;
+    timer_unlink(t);
+}
+
+// Move the timers in the current slot of a level down.  Return the slot index; the level above
+// is cascaded too when this is 0.
+static uint32_t wheel_cascade(WHEEL *w, int level) {
+    uint32_t index = (w->jiffies >> (TV1_BITS + (uint32_t)level * TVN_BITS)) & (TVN_SIZE - 1U);
+    SWTIMER *t = w->tvn[level][index];
+    w->tvn[level][index] = NULL;
+    while (t) {
+        SWTIMER *next = t->next;
+        wheel_add(w, t);
+        w->cascaded++;
+        t = next;
+    }
+    return index;
+}
+
+static void timer_start(WHEEL *w, SWTIMER *timer, uint32_t delay_ms, uint32_t period_ms,
+                        SWTIMER_FN function, uintptr_t context, uint32_t flags) {
+    if (delay_ms > SWTIMER_MAX_MS) delay_ms = SWTIMER_MAX_MS;
+    if (period_ms > SWTIMER_MAX_MS) period_ms = SWTIMER_MAX_MS;
+    uint32_t primask = swtimer_lock();
+    if (timer->pprev) timer_remove(w, timer);
+    timer->expires = w->jiffies - 1U + delay_ms;            // jiffies - 1 is the current tick
+    timer->period_ms = period_ms;
+    timer->function = function;
+    timer->context = context;
+    timer->flags = flags & ~SWTIMER_QUEUED;
+    wheel_add(w, timer);
+    w->pending++;
+    swtimer_unlock(primask);
+}
+
+static void timer_cancel(WHEEL *w, SWTIMER *timer) {
+    uint32_t primask = swtimer_lock();
+    if (timer->pprev) timer_remove(w, timer);
+    swtimer_unlock(primask);
+}
+
+// Process the ticks up to and including now.  SWTIMER_ISR functions are called, other expired
+// timers are put on the ready list.  Return the number put on the ready list.
+static uint32_t wheel_advance(WHEEL *w, uint32_t now) {
+    uint32_t queued = 0;
+    while ((int32_t)(now - w->jiffies) >= 0) {
+        uint32_t primask = swtimer_lock();
+        uint32_t index = w->jiffies & (TV1_SIZE - 1U);
+        if (index == 0U) {
+            for (int level = 0; level < TVN_LEVELS && wheel_cascade(w, level) == 0U; level++) {
+            }
+        }
+        w->jiffies++;
+
+        // Take the slot as a work list, the functions may cancel timers on it
+        SWTIMER *work = w->tv1[index];
+        w->tv1[index] = NULL;
+        if (work) work->pprev = &work;
+        while (work) {
+            SWTIMER *t = work;
+            timer_unlink(t);
+            w->pending--;
+            w->expired++;
+            if (t->flags & SWTIMER_ISR) {
+                if (t->period_ms) {
+                    t->expires += t->period_ms;
+                    wheel_add(w, t);
+                    w->pending++;
+                }
+                w->isr_calls++;
+                swtimer_unlock(primask);
+                t->function(t->context);
+                primask = swtimer_lock();
+            } else {
+                ready_append(t);    // periodic ones are started again when they run
+                queued++;
+            }
+        }
+        swtimer_unlock(primask);
+    }
+    return queued;
+}
+
+// The first tick that expires or cascades a timer, so no timer expires before it.  Return false
+// if the wheel is empty.
+static bool wheel_next_event(const WHEEL *w, uint32_t *tick) {
+    bool found = false;
+    uint32_t next = 0;
+    if (w->pending == 0U) return false;
+
+    for (uint32_t i = 0; i < TV1_SIZE; i++) {
+        if (w->tv1[(w->jiffies + i) & (TV1_SIZE - 1U)]) {
+            next = w->jiffies + i;
+            found = true;
+            break;
+        }
+    }
+    // Level n cascades at multiples of its slot size, the first at or after jiffies
+    uint32_t shift = TV1_BITS;
+    for (int level = 0; level < TVN_LEVELS; level++, shift += TVN_BITS) {
+        uint32_t boundary = ((w->jiffies + (1U << shift) - 1U) >> shift) << shift;
+        for (uint32_t i = 0; i < TVN_SIZE; i++, boundary += 1U << shift) {
+            if (found && (int32_t)(boundary - next) >= 0) break;
+            if (w->tvn[level][(boundary >> shift) & (TVN_SIZE - 1U)]) {
+                next = boundary;
+                found = true;
+                break;
+            }
+        }
+    }
+    *tick = next;
+    return found;
+}
+
+//=================================================================================================
+// Timers
+//=================================================================================================
+
+// SysTick callback, every 1 ms tick
+static void swtimer_tick(uintptr_t context) {
+    (void)context;
+    uint32_t start = DWT->CYCCNT;
+    if (wheel_advance(&wheel, SYSTICK_GetTickCounter())) sched_task_trigger(ready_task);
+    uint32_t cycles = DWT->CYCCNT - start;
+    if (cycles > max_tick_cycles) max_tick_cycles = cycles;
+}
+
+// Scheduler task: call the functions of the expired main loop timers, oldest first
+static void swtimer_task(uintptr_t context) {
+    (void)context;
+    for (;;) {
+        uint32_t primask = swtimer_lock();
+        SWTIMER *t = ready;
+        if (t == NULL) {
+            swtimer_unlock(primask);
+            break;
+        }
+        timer_unlink(t);
+        t->flags &= ~SWTIMER_QUEUED;
+        if (t->period_ms) {
+            t->expires += t->period_ms;
+            uint32_t late = (wheel.jiffies - 1U) - t->expires;
+            if ((int32_t)late >= 0) {
+                // Missed one or more periods, skip them rather than running back to back
+                overruns++;
+                t->expires += (late / t->period_ms + 1U) * t->period_ms;
+            }
+            wheel_add(&wheel, t);
+            wheel.pending++;
+        }
+        swtimer_unlock(primask);
+        main_calls++;
+        t->function(t->context);
+    }
+}
+
+void swtimer_init(void) {
+    wheel.jiffies = SYSTICK_GetTickCounter() + 1U;
+    ready_task = sched_task_create("swtimer", swtimer_task, 0U, SCHED_PRIORITY_HIGH, 0U, 0U);
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    SYSTICK_TimerCallbackSet(swtimer_tick, 0U);
+    cl_register(swtimer_cmd_table);
+}
+
+// Start (or restart) a timer: function(context) is called after delay_ms, then every period_ms
+// (0: once).  A delay of 0 or 1 expires on the next tick.  flags: SWTIMER_ISR to call the function
+// from the SysTick interrupt rather than the main loop.
+void swtimer_start(SWTIMER *timer, uint32_t delay_ms, uint32_t period_ms,
+                   SWTIMER_FN function, uintptr_t context, uint32_t flags) {
+    timer_start(&wheel, timer, delay_ms, period_ms, function, context, flags);
+}
+
+// Stop a timer.  Its function won't be called again, unless it is already running.
+void swtimer_cancel(SWTIMER *timer) {
+    timer_cancel(&wheel, timer);
+}
+
+// The tick count by which the next timer expires (or moves down the wheel), for tickless idle
+// (power.c).  Return false if no timer is started.  Call with interrupts disabled.
+bool swtimer_next_expiry(uint32_t *tick) {
+    return wheel_next_event(&wheel, tick);
+}
+
+// True if the timer is started and hasn't expired, or has expired and waits for the main loop
+bool swtimer_pending(const SWTIMER *timer) {
+    return timer->pprev != NULL;
+}
+
+//=================================================================================================
+// "timers bench": the cost of each operation with 16 to SWTIMER_BENCH_MAX timers in a wheel of
+// its own, driven here rather than by SysTick.  Delays are random over SWTIMER_BENCH_SPAN ticks,
+// so timers are put in levels 0 to 2 and cascaded.  The expire cost includes the cascades.
+//=================================================================================================
+static SWTIMER bench_timers[SWTIMER_BENCH_MAX];
+static WHEEL bench_wheel;
+static uint32_t bench_fired;
+
+static void bench_expired(uintptr_t context) {
+    (void)context;
+    bench_fired++;
+}
+
+static uint32_t bench_random(uint32_t *state) {
+    uint32_t x = *state;    // xorshift32
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static void bench_start_all(uint32_t count, uint32_t seed) {
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t delay = 1U + bench_random(&seed) % (SWTIMER_BENCH_SPAN - 1U);
+        timer_start(&bench_wheel, &bench_timers[i], delay, 0U, bench_expired, 0U, SWTIMER_ISR);
+    }
+}
+
+// Cycles for one tick of the bench wheel
+static uint32_t bench_tick(void) {
+    uint32_t start = DWT->CYCCNT;
+    wheel_advance(&bench_wheel, bench_wheel.jiffies);
+    return DWT->CYCCNT - start;
+}
+
+// Cycles spent expiring and cascading the bench timers.  Advance the wheel SWTIMER_BENCH_SPAN
+// ticks, one at a time, adding up only the ticks that expired or cascaded timers, less an empty
+// tick each.
+static uint32_t bench_expire(uint32_t empty_tick) {
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < SWTIMER_BENCH_SPAN; i++) {
+        uint32_t cascaded = bench_wheel.cascaded;
+        bool busy = (bench_wheel.tv1[bench_wheel.jiffies & (TV1_SIZE - 1U)] != NULL);
+        uint32_t cycles = bench_tick();
+        busy = busy || (bench_wheel.cascaded != cascaded);
+        if (busy && cycles > empty_tick) total += cycles - empty_tick;
+    }
+    return total;
+}
+
+static void swtimer_bench(void) {
+    uint32_t empty_tick = UINT32_MAX;
+    uint32_t overhead = UINT32_MAX;     // reading CYCCNT twice
+    for (int i = 0; i < 16; i++) {
+        uint32_t start = DWT->CYCCNT;
+        uint32_t cycles = DWT->CYCCNT - start;
+        if (cycles < overhead) overhead = cycles;
+    }
+    memset(&bench_wheel, 0, sizeof(bench_wheel));
+    for (uint32_t i = 1; i < TV1_SIZE; i++) {
+        uint32_t cycles = bench_tick();
+        if (cycles < empty_tick) empty_tick = cycles;
+    }
+
+    log_msg("Cycles per timer, delays 1 to %lu ms, best of %lu for insert and cancel\n",
+            SWTIMER_BENCH_SPAN - 1U, SWTIMER_BENCH_ROUNDS);
+    log_msg("Timers   Insert   Cancel   Expire\n");
+    for (uint32_t count = 16U; count <= SWTIMER_BENCH_MAX; count *= 4U) {
+        uint32_t insert = UINT32_MAX;
+        uint32_t cancel = UINT32_MAX;
+        for (uint32_t round = 0; round < SWTIMER_BENCH_ROUNDS; round++) {
+            memset(&bench_wheel, 0, sizeof(bench_wheel));
+            memset(bench_timers, 0, sizeof(bench_timers));
+            uint32_t start = DWT->CYCCNT;
+            bench_start_all(count, count);
+            uint32_t cycles = DWT->CYCCNT - start - overhead;
+            if (cycles < insert) insert = cycles;
+
+            start = DWT->CYCCNT;
+            for (uint32_t i = 0; i < count; i++) {
+                timer_cancel(&bench_wheel, &bench_timers[i]);
+            }
+            cycles = DWT->CYCCNT - start - overhead;
+            if (cycles < cancel) cancel = cycles;
+        }
+
+        bench_start_all(count, count);
+        bench_fired = 0;
+        uint32_t expire = bench_expire(empty_tick);
+
+        log_msg("%6lu %8lu %8lu %8lu%s\n", count, insert / count, cancel / count, expire / count,
+                (bench_fired == count) ? "" : "  (timers lost!)");
+    }
+    log_msg("Empty tick: %lu cycles\n", empty_tick);
+}
+
+static int cl_timers(CL_CONTEXT *ctx) {
+    if (ctx->argc > 1 && strcmp(ctx->argv[1], "bench") == 0) {
+        swtimer_bench();
+        return 0;
+    }
+    log_msg("Pending: %lu, expired: %lu, cascaded: %lu\n", wheel.pending, wheel.expired, wheel.cascaded);
+    log_msg("Called from SysTick: %lu, from the main loop: %lu, overruns: %lu\n",
+            wheel.isr_calls, main_calls, overruns);
+    log_msg("Longest tick: %lu cycles\n", max_tick_cycles);
+    return 0;
+}
@@ -0,0 +1,38 @@
+// swtimer.h
+//
+// Software timers on a hierarchical timer wheel driven by the SysTick tick, see swtimer.c
+
+#ifndef SWTIMER_H
+#define SWTIMER_H
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SWTIMER_ISR         (1U << 0)   // call the function from the SysTick interrupt
+#define SWTIMER_MAX_MS      0x7FFFFFFFU // longest delay or period
+
+typedef void (*SWTIMER_FN)(uintptr_t context);
+
+typedef struct SWTIMER SWTIMER;
+
+// Owned by the caller, which may have as many as it likes.  Zero it (or use SWTIMER_INIT) before
+// its first swtimer_start(), and leave the fields to swtimer.c after that.
+struct SWTIMER {
+    SWTIMER *       next;               // wheel slot or ready list
+    SWTIMER **      pprev;              // the link pointing at this timer, NULL when idle
+    uint32_t        expires;            // tick count
+    uint32_t        period_ms;          // 0 for a one-shot timer
+    SWTIMER_FN      function;
+    uintptr_t       context;
+    uint32_t        flags;
+};
+
+#define SWTIMER_INIT    {NULL, NULL, 0U, 0U, NULL, 0U, 0U}
+
+void swtimer_init(void);
+void swtimer_start(SWTIMER *timer, uint32_t delay_ms, uint32_t period_ms,
+                   SWTIMER_FN function, uintptr_t context, uint32_t flags);
+void swtimer_cancel(SWTIMER *timer);
+bool swtimer_pending(const SWTIMER *timer);
+bool swtimer_next_expiry(uint32_t *tick);
+
+#endif // SWTIMER_H
@@ -0,0 +1,134 @@
+/**************************************************************************************************
+timebase.c
+64-bit monotonic timebase
+
+TC0 counts microseconds in 32 bits and wraps every 71.58 minutes; SysTick's tick count and the
+DWT cycle counter wrap too.  timebase_us() extends TC0 to 64 bits, and timebase_cycles() adds the
+sub-microsecond part from CYCCNT, so durations and timestamps stay right over any run length.
+
+Extending TC0: the TC0 interrupt counts half periods in "halves", at the compare match with CC1 =
+0x80000000 (halfway) and at the overflow.  Ideally halves is twice the wrap count, plus one while
+the count's top bit is set.  A reader takes halves, then the count; if the parity of halves doesn't
+match the top bit, the interrupt for the half period just ended hasn't run yet (or ran between the
+two reads) and halves is one behind.  So there is no retry loop and no lock, halves is a single
+word written only by the interrupt, and readers may run at any interrupt level, or with interrupts
+disabled for up to half a period (35 minutes).
+
+Cycles: the CPU clock (DPLL0) is locked to TC0's 1 MHz GCLK2, 120 cycles per microsecond, but
+CYCCNT stops while the core sleeps in WFI.  timebase_cycles() keeps the offset between CYCCNT and
+the microsecond count, takes CYCCNT's part of a microsecond from it, and re-aligns the offset when
+CYCCNT has fallen behind (after a sleep) or been written.  The result is timebase_us() * 120 plus
+0 to 119 cycles, never going backwards; differences between readings are exact to the cycle while
+the core stays awake.
+
+"uptime" shows both, and the TC0 wraps so far.
+
+**************************************************************************************************/
+
+#include "timebase.h"
+#include "definitions.h"                // SYS function prototypes
+#include "command_line.h"
+#include "logger.h"
+#include "bench.h"
+
+#define CYCLES_PER_US       (CPU_CLOCK_FREQUENCY / 1000000U)
+#define TC0_HALF_PERIOD     0x80000000U
+#define CYCLES_SLACK        (4U * CYCLES_PER_US)    // TC0 read synchronization, before re-aligning
+
+static volatile uint32_t halves;        // TC0 half periods, written only by the TC0 interrupt
+static volatile uint32_t cycle_offset;  // CYCCNT - cycles of the microsecond count, while in step
+static volatile uint32_t cycle_realigns;
+
+static int cl_uptime(CL_CONTEXT *ctx);
+static void bench_timebase_us(void);
+static void bench_timebase_cycles(void);
+
+static const COMMAND_ITEM timebase_cmd_table[] = {
+    {"uptime",    "time since reset from the 64-bit timebase",              cl_uptime},
+    {NULL,NULL,NULL}, /* end of table */
+};
+
+static const BENCH_CASE timebase_bench_table[] = {
+    {"timebase_us", "timebase_us(), as each log record does",       NULL,   bench_timebase_us},
+    {"timebase_cyc", "timebase_cycles()",                           NULL,   bench_timebase_cycles},
+    {NULL,NULL,NULL,NULL}, /* end of table */
+};
+
+// TC0 overflow and CC1 match, each the end of a half period
+static void timebase_tc0_callback(TC_TIMER_STATUS status, uintptr_t context) {
+    (void)context;
+    uint32_t count = halves;
+    if (status & TC_TIMER_STATUS_MATCH1) count++;
+    if (status & TC_TIMER_STATUS_OVERFLOW) count++;
+    halves = count;
+}
+
+// Call with TC0 running as a free running 32-bit counter (main.c)
+void timebase_init(void) {
+    TC0_Timer32bitCompareSet(TC0_HALF_PERIOD);
+    halves = TC0_Timer32bitCounterGet() >> 31;
+    TC0_REGS->COUNT32.TC_INTFLAG = (uint8_t)(TC_INTFLAG_OVF_Msk | TC_INTFLAG_MC1_Msk);
+    TC0_REGS->COUNT32.TC_INTENSET = (uint8_t)TC_INTENSET_MC1_Msk;
+    TC0_TimerCallbackRegister(timebase_tc0_callback, 0U);
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    cl_register(timebase_cmd_table);
+    bench_register(timebase_bench_table);
+}
+
+// Microseconds since TC0 started.  Safe from any interrupt level.
+uint64_t timebase_us(void) {
+    uint32_t h = halves;
+    uint32_t count = TC0_Timer32bitCounterGet();
+    h += (h ^ (count >> 31)) & 1U;      // one behind if the parity doesn't match the top bit
+    return ((uint64_t)(h >> 1) << 32) | count;
+}
+
+// CPU cycles since TC0 started, timebase_us() with CYCCNT's part of the microsecond.
+// Safe from any interrupt level.
+uint64_t timebase_cycles(void) {
+    uint32_t cycles = DWT->CYCCNT;
+    uint64_t base = timebase_us() * CYCLES_PER_US;
+    int32_t part = (int32_t)(cycles - cycle_offset - (uint32_t)base);
+
+    if (part < -(int32_t)CYCLES_SLACK || part > (int32_t)(CYCLES_SLACK + CYCLES_PER_US)) {
+        cycle_offset = cycles - (uint32_t)base;     // CYCCNT fell behind while asleep, or was written
+        cycle_realigns++;
+        part = 0;
+    }
+    if (part < 0) part = 0;
+    if (part >= (int32_t)CYCLES_PER_US) part = CYCLES_PER_US - 1U;
+    return base + (uint32_t)part;
+}
+
+// Split a microsecond time into whole seconds and the microseconds left over, for printing
+void timebase_split(uint64_t us, uint32_t *seconds, uint32_t *micros) {
+    *seconds = (uint32_t)(us / 1000000U);
+    *micros = (uint32_t)(us % 1000000U);
+}
+
+static int cl_uptime(CL_CONTEXT *ctx) {
+    uint64_t cycles = timebase_cycles();
+    uint64_t us = timebase_us();
+    uint32_t seconds;
+    uint32_t micros;
+
+    timebase_split(us, &seconds, &micros);
+    log_msg("Uptime: %lu.%06lu s (%lu:%02lu:%02lu)\n", seconds, micros,
+            seconds / 3600U, (seconds / 60U) % 60U, seconds % 60U);
+    log_msg("Cycles: 0x%08lX%08lX at %lu MHz, %lu realigned after sleep\n",
+            (uint32_t)(cycles >> 32), (uint32_t)cycles, CYCLES_PER_US, cycle_realigns);
+    log_msg("TC0 wraps: %lu\n", (uint32_t)(us >> 32));
+    return (int)seconds;
+}
+
+static volatile uint64_t bench_time;
+
+static void bench_timebase_us(void) {
+    bench_time = timebase_us();
+}
+
+static void bench_timebase_cycles(void) {
+    bench_time = timebase_cycles();
+}
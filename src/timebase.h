@@ -0,0 +1,14 @@
+// timebase.h
+//
+// 64-bit microsecond and CPU cycle timebase that never wraps, see timebase.c
+
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+#include <stdint.h>
+
+void timebase_init(void);
+uint64_t timebase_us(void);
+uint64_t timebase_cycles(void);
+void timebase_split(uint64_t us, uint32_t *seconds, uint32_t *micros);
+
+#endif // TIMEBASE_H
@@ -0,0 +1,296 @@
+/**************************************************************************************************
+uart.c
+SERCOM5 console UART support
+
+The SERCOM5 plib sends the write ring buffer either with the DMA (one interrupt per block of up to
+256 bytes) or with the data register empty interrupt (one interrupt per byte).  It receives into
+the read ring buffer either with a circular DMA, woken by the start of frame interrupt and polled
+by TC2 two character times later, then every millisecond until the line goes idle, or with the
+receive complete interrupt (one interrupt per byte).  It counts the interrupts, bytes and handler cycles of all of them, using the
+DWT cycle counter enabled here.
+
+"uartstats" shows the counters and an estimate of the CPU time the DMA saved, based on the
+per-byte cost measured while the interrupt transmitter or receiver was in use.
+"uartstats txdma|rxdma off" selects the interrupt transmitter or receiver so its cost can be
+measured, "uartstats txdma|rxdma on" goes back to the DMA, "uartstats reset" clears the counters.
+
+"baud <rate>" switches SERCOM5 to another baud rate (up to 1/8 of the 60 MHz GCLK1, e.g. 1-3 Mbaud)
+once the transmitter has drained.  Unless "baud ok" arrives at the new rate within BAUD_CONFIRM_MS
+the rate goes back to 115200, so a terminal that cannot follow is not locked out.  "baudtest [bytes]"
+streams BAUDTEST_LINE_SIZE byte lines of a fixed pattern, each starting with its byte offset in hex,
+then reports the achieved bytes/s against the line rate and the receive errors from
+SERCOM5_USART_ErrorGet() seen meanwhile.  It runs as a job (job.c), so "baudtest &" streams in the
+background.  tools/baud_test.py drives both from a PC.
+
+The "bench" cases uart_write, uart_pull and uart_read time the SERCOM5 ring buffer code on
+UART_BENCH_SIZE bytes: SERCOM5_USART_Write(), the per-byte pull of the data register empty
+interrupt, and SERCOM5_USART_Read(), see SERCOM5_USART_RingBenchmark().
+
+**************************************************************************************************/
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "uart.h"
+#include "definitions.h"                // SYS function prototypes
+#include "command_line.h"
+#include "logger.h"
+#include "scheduler.h"
+#include "job.h"
+#include "bench.h"
+
+#define CYCLES_PER_US   (CPU_CLOCK_FREQUENCY / 1000000U)
+
+#define BAUD_DEFAULT        115200U     // matches SERCOM5_USART_INT_BAUD_VALUE
+#define BAUD_MIN            1200U
+#define BAUD_CONFIRM_MS     3000U       // time to send "baud ok" at the new rate
+#define BAUD_DRAIN_US       100000U     // longest wait for the transmitter to empty
+#define BAUDTEST_LINE_SIZE  64U
+#define BAUDTEST_DEFAULT    "65536"     // bytes
+#define UART_BENCH_SIZE     256U        // bytes per ring buffer benchmark iteration
+
+static uint32_t uart_baud = BAUD_DEFAULT;
+static int baud_revert_task = -1;
+
+static int cl_uartstats(CL_CONTEXT *ctx);
+static int cl_baud(CL_CONTEXT *ctx);
+static int cl_baudtest(CL_CONTEXT *ctx);
+
+static const CL_ARG baudtest_args[] = {
+    {"bytes",     CL_ARG_INT,     1, INT32_MAX, BAUDTEST_DEFAULT},
+    {NULL},
+};
+
+static const COMMAND_ITEM uart_cmd_table[] = {
+    {"uartstats", "UART interrupt statistics, \"uartstats reset|txdma on|off|rxdma on|off\"", cl_uartstats},
+    {"baud",      "Show or change the baud rate, \"baud <rate>\", then \"baud ok\" to keep it", cl_baud},
+    {"baudtest",  "Stream a test pattern and report bytes/s, \"baudtest [bytes]\"", cl_baudtest, baudtest_args},
+    {NULL,NULL,NULL}, /* end of table */
+};
+
+static uint8_t bench_data[UART_BENCH_SIZE];
+
+static void bench_uart_write(void) {
+    (void)SERCOM5_USART_RingBenchmark(SERCOM_USART_RING_OP_WRITE, bench_data, UART_BENCH_SIZE);
+}
+
+static void bench_uart_pull(void) {
+    (void)SERCOM5_USART_RingBenchmark(SERCOM_USART_RING_OP_PULL, bench_data, UART_BENCH_SIZE);
+}
+
+static void bench_uart_read(void) {
+    (void)SERCOM5_USART_RingBenchmark(SERCOM_USART_RING_OP_READ, bench_data, UART_BENCH_SIZE);
+}
+
+static const BENCH_CASE uart_bench_table[] = {
+    {"uart_write",  "SERCOM5_USART_Write() of 256 bytes",           NULL,   bench_uart_write},
+    {"uart_pull",   "256 bytes pulled as the TX interrupt does",    NULL,   bench_uart_pull},
+    {"uart_read",   "SERCOM5_USART_Read() of 256 bytes",            NULL,   bench_uart_read},
+    {NULL,NULL,NULL,NULL}, /* end of table */
+};
+
+void uart_init(void) {
+    // Cycle counter for the SERCOM5 interrupt statistics
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    cl_register(uart_cmd_table);
+    bench_register(uart_bench_table);
+}
+
+// Estimate the handler time the DMA saved from the measured per-byte interrupt cost
+static void print_saved(const char *dir, uint32_t dma_bytes, uint32_t dma_cycles,
+                        uint32_t isr_bytes, uint32_t isr_cycles) {
+    if (isr_bytes == 0) {
+        log_msg("%s CPU time saved: unknown, measure the interrupt cost with \"uartstats %sdma off\"\n",
+                dir, strcmp(dir, "TX") == 0 ? "tx" : "rx");
+        return;
+    }
+    // Handler time only, exception entry and exit are not included
+    uint64_t isr_total = ((uint64_t)dma_bytes * isr_cycles) / isr_bytes;
+    uint64_t saved = (isr_total > dma_cycles) ? isr_total - dma_cycles : 0;
+    log_msg("%s CPU time saved: %lu us (%lu cycles/byte by interrupt)\n", dir,
+            (uint32_t)(saved / CYCLES_PER_US), isr_cycles / isr_bytes);
+}
+
+static int cl_uartstats(CL_CONTEXT *ctx) {
+    if (ctx->argc > 1 && strcmp(ctx->argv[1], "reset") == 0) {
+        SERCOM5_USART_StatsReset();
+        return 0;
+    }
+    if (ctx->argc > 1 && (strcmp(ctx->argv[1], "txdma") == 0 || strcmp(ctx->argv[1], "rxdma") == 0)) {
+        bool tx = (ctx->argv[1][0] == 't');
+        if (ctx->argc < 3 || (strcmp(ctx->argv[2], "on") != 0 && strcmp(ctx->argv[2], "off") != 0)) {
+            log_msg("uartstats %s on|off\n", ctx->argv[1]);
+            return 1;
+        }
+        bool on = (strcmp(ctx->argv[2], "on") == 0);
+        if (tx) {
+            SERCOM5_USART_TxDmaEnable(on);
+        } else if (!SERCOM5_USART_RxDmaEnable(on)) {
+            log_msg("RX DMA needs 8-bit data and an empty receive buffer\n");
+            return 1;
+        }
+        return 0;
+    }
+
+    SERCOM_USART_STATS s;
+    SERCOM5_USART_StatsGet(&s);
+
+    log_msg("TX mode: %s\n", SERCOM5_USART_TxDmaIsEnabled() ? "DMA" : "interrupt");
+    log_msg("Interrupt TX: %8lu isr %8lu bytes %6lu cycles/isr\n", s.txIsrCount, s.txIsrBytes,
+            s.txIsrCount ? s.txIsrCycles / s.txIsrCount : 0);
+    log_msg("DMA TX:       %8lu isr %8lu bytes %6lu cycles/isr %lu blocks %lu errors\n",
+            s.txDmaIsrCount, s.txDmaBytes, s.txDmaIsrCount ? s.txDmaIsrCycles / s.txDmaIsrCount : 0,
+            s.txDmaBlocks, s.txDmaErrors);
+
+    log_msg("RX mode: %s\n", SERCOM5_USART_RxDmaIsEnabled() ? "DMA" : "interrupt");
+    log_msg("Interrupt RX: %8lu isr %8lu bytes %6lu cycles/isr\n", s.rxIsrCount, s.rxIsrBytes,
+            s.rxIsrCount ? s.rxIsrCycles / s.rxIsrCount : 0);
+    log_msg("DMA RX:       %8lu isr %8lu bytes %6lu cycles/isr %lu overruns\n",
+            s.rxDmaIsrCount, s.rxDmaBytes, s.rxDmaIsrCount ? s.rxDmaIsrCycles / s.rxDmaIsrCount : 0,
+            s.rxDmaOverruns);
+    log_msg("RX notifications: %lu\n", s.rxNotifications);
+
+    // The interrupt transmitter and receiver take one interrupt per byte
+    uint32_t tx_avoided = (s.txDmaBytes > s.txDmaIsrCount) ? s.txDmaBytes - s.txDmaIsrCount : 0;
+    uint32_t rx_avoided = (s.rxDmaBytes > s.rxDmaIsrCount) ? s.rxDmaBytes - s.rxDmaIsrCount : 0;
+    log_msg("Interrupts avoided by DMA: TX %lu RX %lu\n", tx_avoided, rx_avoided);
+    print_saved("TX", s.txDmaBytes, s.txDmaIsrCycles, s.txIsrBytes, s.txIsrCycles);
+    print_saved("RX", s.rxDmaBytes, s.rxDmaIsrCycles, s.rxIsrBytes, s.rxIsrCycles);
+    return 0;
+}
+
+// Wait until everything queued has left the shift register, or BAUD_DRAIN_US
+static void uart_drain(void) {
+    uint32_t start_us = TC0_Timer32bitCounterGet();
+    while ((SERCOM5_USART_WriteCountGet() != 0U || !SERCOM5_USART_TransmitComplete()) &&
+           (TC0_Timer32bitCounterGet() - start_us) < BAUD_DRAIN_US) {
+    }
+}
+
+// Reprogram SERCOM5 for 8N1 at baud.  Characters still queued would go out at the wrong rate,
+// so the transmitter is drained first.
+static bool uart_set_baud(uint32_t baud) {
+    USART_SERIAL_SETUP setup = {
+        .baudRate  = baud,
+        .parity    = USART_PARITY_NONE,
+        .dataWidth = USART_DATA_8_BIT,
+        .stopBits  = USART_STOP_0_BIT,  // Harmony's name for one stop bit
+    };
+
+    uart_drain();
+    if (!SERCOM5_USART_SerialSetup(&setup, 0U)) return false;
+    uart_baud = baud;
+    return true;
+}
+
+// One-shot task, "baud ok" did not arrive in time
+static void baud_revert(uintptr_t context) {
+    (void)context;
+    baud_revert_task = -1;
+    uart_set_baud(BAUD_DEFAULT);
+    log_msg("\nNo \"baud ok\", back to %lu baud\n>", uart_baud);
+}
+
+static int cl_baud(CL_CONTEXT *ctx) {
+    if (ctx->argc < 2) {
+        log_msg("%lu baud\n", uart_baud);
+        return 0;
+    }
+    if (strcmp(ctx->argv[1], "ok") == 0) {
+        if (baud_revert_task >= 0) {
+            sched_task_cancel(baud_revert_task);
+            baud_revert_task = -1;
+        }
+        log_msg("Keeping %lu baud\n", uart_baud);
+        return 0;
+    }
+
+    uint32_t baud = strtoul(ctx->argv[1], NULL, 0);
+    uint32_t max = SERCOM5_USART_FrequencyGet() / 8U;
+    if (baud < BAUD_MIN || baud > max) {
+        log_msg("Baud rate must be %lu to %lu\n", BAUD_MIN, max);
+        return 1;
+    }
+    if (baud_revert_task >= 0) {
+        // Changing again before confirming restarts the timeout
+        sched_task_cancel(baud_revert_task);
+        baud_revert_task = -1;
+    }
+    if (baud != BAUD_DEFAULT) {
+        baud_revert_task = sched_task_create("baud", baud_revert, 0, SCHED_PRIORITY_HIGH,
+                                             BAUD_CONFIRM_MS, 0);
+        if (baud_revert_task < 0) {
+            log_msg("No free task slot for the baud rate timeout\n");
+            return 1;
+        }
+        log_msg("Switching to %lu baud, send \"baud ok\" within %lu ms to keep it\n",
+                baud, BAUD_CONFIRM_MS);
+    }
+    uart_set_baud(baud);
+    return 0;
+}
+
+// baudtest state, in job->data
+typedef struct {
+    uint32_t bytes;
+    uint32_t lines;
+    uint32_t line;                  // next line to send
+    uint32_t parity;
+    uint32_t framing;
+    uint32_t overrun;
+    uint32_t start_us;
+} BAUDTEST_STATE;
+
+// Queue as many pattern lines as fit in the write ring, then yield until there is room for more
+static JOB_STATUS baudtest_step(JOB *job) {
+    static const char pattern[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+    BAUDTEST_STATE *s = (BAUDTEST_STATE *)job->data;
+    char line[BAUDTEST_LINE_SIZE + 1];
+
+    JOB_BEGIN(job);
+    s->bytes = (uint32_t)job->ctx.args[0].i;
+    s->lines = (s->bytes + BAUDTEST_LINE_SIZE - 1U) / BAUDTEST_LINE_SIZE;
+    s->bytes = s->lines * BAUDTEST_LINE_SIZE;
+    uart_drain();
+    (void)SERCOM5_USART_ErrorGet(); // clear any old error
+
+    s->start_us = TC0_Timer32bitCounterGet();
+    while (s->line < s->lines) {
+        if (SERCOM5_USART_WriteFreeBufferCountGet() < BAUDTEST_LINE_SIZE) {
+            JOB_YIELD(job);
+            continue;
+        }
+        // "<offset> <pattern>\r\n", BAUDTEST_LINE_SIZE bytes
+        int n = snprintf(line, sizeof(line), "%08lX ", (unsigned long)(s->line * BAUDTEST_LINE_SIZE));
+        memcpy(&line[n], pattern, BAUDTEST_LINE_SIZE - 2U - n);
+        line[BAUDTEST_LINE_SIZE - 2U] = '\r';
+        line[BAUDTEST_LINE_SIZE - 1U] = '\n';
+        (void)SERCOM5_USART_Write((uint8_t *)line, BAUDTEST_LINE_SIZE);
+        s->line++;
+
+        USART_ERROR error = SERCOM5_USART_ErrorGet();
+        if (error & USART_ERROR_PARITY)  s->parity++;
+        if (error & USART_ERROR_FRAMING) s->framing++;
+        if (error & USART_ERROR_OVERRUN) s->overrun++;
+    }
+    while (SERCOM5_USART_WriteCountGet() != 0U || !SERCOM5_USART_TransmitComplete()) {
+        JOB_YIELD(job);
+    }
+    uint32_t elapsed_us = TC0_Timer32bitCounterGet() - s->start_us;
+
+    // 8N1: 10 bits per byte on the line
+    uint32_t rate = elapsed_us ? (uint32_t)(((uint64_t)s->bytes * 1000000U) / elapsed_us) : 0;
+    uint32_t line_rate = uart_baud / 10U;
+    log_msg("\n%lu bytes in %lu us at %lu baud: %lu bytes/s, %lu%% of %lu bytes/s\n", s->bytes,
+            elapsed_us, uart_baud, rate, (uint32_t)(((uint64_t)rate * 100U) / line_rate), line_rate);
+    log_msg("Receive errors: %lu parity %lu framing %lu overrun\n", s->parity, s->framing, s->overrun);
+    JOB_END(job);
+}
+
+static int cl_baudtest(CL_CONTEXT *ctx) {
+    return job_run(ctx, "baudtest", baudtest_step, 1U);
+}
@@ -0,0 +1,10 @@
+// uart.h
+//
+// SERCOM5 console UART: DMA selection, interrupt statistics and baud rate
+
+#ifndef UART_H
+#define UART_H
+
+void uart_init(void);
+
+#endif // UART_H
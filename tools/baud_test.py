@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+"""
+baud_test.py - switch the command line UART to a higher baud rate and measure throughput
+
+Sends "baud <rate>" at 115200, reopens the port at the new rate and confirms with "baud ok"
+before the firmware's timeout reverts it (BAUD_CONFIRM_MS in src/uart.c).  Then runs
+"baudtest <bytes>" and checks every pattern line:
+    8 hex digit byte offset, space, "0123...xyz" up to 62 characters, CR LF  (64 bytes)
+and reports the rate measured on the PC next to the firmware's own report.
+
+Usage:
+    baud_test.py <serial device> <baud> [bytes]
+
+Needs pyserial (pip install pyserial).
+"""
+
+import sys
+import time
+
+import serial
+
+BAUD_DEFAULT = 115200
+LINE_SIZE = 64
+PATTERN = b'0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz'
+
+
+def command(port, text, wait=0.2):
+    """Send a command line, return whatever comes back within wait seconds"""
+    port.reset_input_buffer()
+    port.write(text.encode() + b'\r')
+    time.sleep(wait)
+    return port.read(port.in_waiting).decode(errors='replace')
+
+
+def expected_line(offset):
+    head = b'%08X ' % offset
+    return head + PATTERN[:LINE_SIZE - 2 - len(head)] + b'\r\n'
+
+
+def main():
+    if len(sys.argv) < 3:
+        sys.exit(__doc__)
+    device, baud = sys.argv[1], int(sys.argv[2])
+    nbytes = int(sys.argv[3]) if len(sys.argv) > 3 else 65536
+
+    port = serial.Serial(device, BAUD_DEFAULT, timeout=1)
+    print(command(port, 'baud %d' % baud).strip())
+    port.baudrate = baud
+    reply = command(port, 'baud ok')
+    if 'Keeping' not in reply:
+        sys.exit('No confirmation at %d baud, the firmware goes back to %d' % (baud, BAUD_DEFAULT))
+    print(reply.strip())
+
+    port.reset_input_buffer()
+    port.write(b'baudtest %d\r' % nbytes)
+    nlines = (nbytes + LINE_SIZE - 1) // LINE_SIZE
+    good = bad = 0
+    start = None
+    while good + bad < nlines:
+        line = port.readline()
+        if not line:
+            break
+        if start is None:
+            if len(line) < 9 or line[:8].strip(b'0123456789ABCDEF') or line[8:9] != b' ':
+                continue            # command echo
+            start = time.monotonic()
+        if line == expected_line((good + bad) * LINE_SIZE):
+            good += 1
+        else:
+            bad += 1
+    elapsed = time.monotonic() - start if start else 0
+    print(port.read_until(b'>').decode(errors='replace').strip())
+
+    received = (good + bad) * LINE_SIZE
+    print('PC: %d of %d lines good, %d bad' % (good, nlines, bad))
+    if elapsed:
+        print('PC: %d bytes/s' % (received / elapsed))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+"""
+log_decode.py - decode dictionary log records (LOG_DICT() in src/logger.h)
+
+The firmware sends normal text mixed with binary dictionary records:
+    0x1E, varint (ID << 3 | argument count), timestamp (low 32 bits of the us time),
+    arguments (varint each)
+A varint is 7 bits per byte, low bits first, the top bit set on all but the last byte.
+The timestamp is little-endian, and is extended to 64 bits here by counting wraps, so
+records must be less than 71 minutes apart.  The ID is the format string's address in
+the .log_fmt section of the ELF file (the low 16 bits, from the section start).  %s arguments are
+target addresses, read from the ELF file.  The host simulation's ELF file (tools/sim/sim,
+64-bit, .log_fmt loaded) decodes the same way, see tools/sim/log_roundtrip.py.
+
+Usage:
+    log_decode.py <firmware.elf> [capture]     (capture file or serial device, default stdin)
+
+For a serial device, set the line up first, e.g.  stty -F /dev/ttyACM0 115200 raw
+"""
+
+import re
+import struct
+import sys
+
+LOG_DICT_SYNC = 0x1E
+
+# printf conversion: flags, width, precision, length modifier, conversion
+FORMAT_SPEC = re.compile(r'%([-+ #0]*)(\d*|\*)(\.\d+)?(hh|h|ll|l|z|j|t)?([diouxXcsp%])')
+
+
+class Elf:
+    """Just enough ELF32/ELF64 little-endian parsing to read sections by name and address"""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF' or self.data[4] not in (1, 2) or self.data[5] != 1:
+            raise ValueError('%s: not a little-endian ELF file' % path)
+        if self.data[4] == 1:
+            shoff, = struct.unpack_from('<I', self.data, 0x20)
+            shentsize, shnum, shstrndx = struct.unpack_from('<HHH', self.data, 0x2E)
+            header = '<IIIIIIIIII'
+        else:
+            shoff, = struct.unpack_from('<Q', self.data, 0x28)
+            shentsize, shnum, shstrndx = struct.unpack_from('<HHH', self.data, 0x3A)
+            header = '<IIQQQQIIQQ'
+        headers = [struct.unpack_from(header, self.data, shoff + i * shentsize)
+                   for i in range(shnum)]
+        strtab_offset = headers[shstrndx][4]
+        self.sections = []
+        for name, sh_type, flags, addr, offset, size, _, _, _, _ in headers:
+            end = self.data.index(b'\0', strtab_offset + name)
+            section_name = self.data[strtab_offset + name:end].decode()
+            self.sections.append((section_name, sh_type, flags, addr, offset, size))
+
+    def section(self, name):
+        for section_name, sh_type, _, addr, offset, size in self.sections:
+            if section_name == name:
+                return addr, self.data[offset:offset + size]
+        raise KeyError('section %s not found' % name)
+
+    def string_at(self, address):
+        """Read a C string from a loaded (SHF_ALLOC) section containing address"""
+        for _, sh_type, flags, addr, offset, size in self.sections:
+            if sh_type == 1 and flags & 0x2 and addr <= address < addr + size:
+                start = offset + address - addr
+                return self.data[start:self.data.index(b'\0', start)].decode(errors='replace')
+        return '<0x%08x>' % address
+
+
+def format_record(elf, fmt_strings, fmt_id, args):
+    """Rebuild the text of one record from its format string and 32-bit argument words"""
+    end = fmt_strings.find(b'\0', fmt_id)
+    if fmt_id >= len(fmt_strings) or end < 0:
+        return '<unknown format id %d>' % fmt_id
+    fmt = fmt_strings[fmt_id:end].decode(errors='replace')
+    args = list(args)
+
+    def convert(match):
+        flags, width, precision, _, conversion = match.groups()
+        if conversion == '%':
+            return '%'
+        if width == '*':
+            width = str(struct.unpack('<i', struct.pack('<I', args.pop(0) if args else 0))[0])
+        value = args.pop(0) if args else 0
+        spec = '%' + flags + width + (precision or '')
+        if conversion in 'di':
+            return (spec + 'd') % struct.unpack('<i', struct.pack('<I', value))[0]
+        if conversion == 'u':
+            return (spec + 'd') % value
+        if conversion in 'oxX':
+            return (spec + conversion) % value
+        if conversion == 'c':
+            return (spec + 'c') % chr(value & 0xFF)
+        if conversion == 's':
+            return (spec + 's') % elf.string_at(value)
+        return '0x%08x' % value  # %p
+
+    return FORMAT_SPEC.sub(convert, fmt)
+
+
+def read_varint(stream):
+    """Read a varint, or return None at the end of the stream"""
+    value = 0
+    for shift in range(0, 35, 7):
+        c = stream.read(1)
+        if not c:
+            return None
+        value |= (c[0] & 0x7F) << shift
+        if not c[0] & 0x80:
+            break
+    return value & 0xFFFFFFFF
+
+
+def decode(elf, stream, out):
+    fmt_base, fmt_strings = elf.section('.log_fmt')
+    timestamp = None    # 64-bit us time of the last record
+    while True:
+        c = stream.read(1)
+        if not c:
+            break
+        if c[0] != LOG_DICT_SYNC:
+            out.write(c.decode('latin-1'))  # normal text output
+            continue
+        header = read_varint(stream)
+        low = stream.read(4)
+        if header is None or len(low) < 4:
+            break
+        fmt_id = ((header >> 3) - fmt_base) & 0xFFFF   # 0 on the target, where .log_fmt isn't loaded
+        nargs = header & 0x7
+        low, = struct.unpack('<I', low)
+        if timestamp is None:
+            timestamp = low
+        else:
+            # Nearest to the last record, records from interrupt handlers may be slightly out of order
+            timestamp += struct.unpack('<i', struct.pack('<I', (low - timestamp) & 0xFFFFFFFF))[0]
+        args = [read_varint(stream) for _ in range(nargs)]
+        if None in args:
+            break
+        out.write('[%u.%06u] %s' % (timestamp // 1000000, timestamp % 1000000,
+                                     format_record(elf, fmt_strings, fmt_id, args)))
+        out.flush()
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit(__doc__)
+    elf = Elf(sys.argv[1])
+    if len(sys.argv) > 2:
+        with open(sys.argv[2], 'rb', buffering=0) as stream:
+            decode(elf, stream, sys.stdout)
+    else:
+        decode(elf, sys.stdin.buffer, sys.stdout)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,114 @@
+/*
+ * parse_bench.c - compare src/parse.c with strtol() and strtof() on a PC
+ *
+ * Checks parse_int() and parse_float() against the C library on random argument strings, then
+ * times both.  Build and run from the repository directory:
+ *     gcc -O2 -Isrc tools/parse_bench.c src/parse.c -lm -o parse_bench && ./parse_bench
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "parse.h"
+
+#define COUNT   100000
+#define LOOPS   20
+
+static char ints[COUNT][16];
+static char floats[COUNT][24];
+static volatile long sink;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void make_strings(void) {
+    srand(1);
+    for (int i = 0; i < COUNT; i++) {
+        int32_t v = (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand()) >> (rand() % 31);
+        if (i % 4 == 0) snprintf(ints[i], sizeof(ints[i]), "0x%X", (unsigned)v);
+        else snprintf(ints[i], sizeof(ints[i]), "%d", v);
+
+        float f = (float)rand() / (float)RAND_MAX * powf(10.0f, (float)(rand() % 20 - 10));
+        if (rand() & 1) f = -f;
+        switch (i % 3) {
+        case 0:  snprintf(floats[i], sizeof(floats[i]), "%.3f", f); break;
+        case 1:  snprintf(floats[i], sizeof(floats[i]), "%.7g", f); break;
+        default: snprintf(floats[i], sizeof(floats[i]), "%.6e", f); break;
+        }
+    }
+}
+
+static int check(void) {
+    int errors = 0;
+    float worst = 0.0f;
+    for (int i = 0; i < COUNT; i++) {
+        int32_t v;
+        long expected = strtoul(ints[i], NULL, 0);
+        if (ints[i][0] == '-') expected = strtol(ints[i], NULL, 0);
+        if (!parse_int(ints[i], &v) || v != (int32_t)expected) {
+            printf("parse_int(\"%s\") = %d, strtol %ld\n", ints[i], v, expected);
+            errors++;
+        }
+        float f;
+        float g = strtof(floats[i], NULL);
+        if (!parse_float(floats[i], &f)) {
+            printf("parse_float(\"%s\") failed\n", floats[i]);
+            errors++;
+        } else if (f != g) {
+            float ulps = fabsf(f - g) / (nextafterf(fabsf(g), INFINITY) - fabsf(g));
+            if (ulps > worst) worst = ulps;
+        }
+    }
+    // Not numbers, or out of range
+    static const char *bad_ints[] = {"", "-", "0x", "12abc", "1.5", "2147483648", "-2147483649",
+                                     "0x1FFFFFFFF", "-0x80000001", "010x"};
+    static const char *bad_floats[] = {"", "-", ".", "12abc", "1.2.3", "1e", "e5", "1e+", "1e39", "0x10"};
+    for (unsigned i = 0; i < sizeof(bad_ints) / sizeof(bad_ints[0]); i++) {
+        int32_t v;
+        if (parse_int(bad_ints[i], &v)) {
+            printf("parse_int(\"%s\") accepted\n", bad_ints[i]);
+            errors++;
+        }
+    }
+    for (unsigned i = 0; i < sizeof(bad_floats) / sizeof(bad_floats[0]); i++) {
+        float f;
+        if (parse_float(bad_floats[i], &f)) {
+            printf("parse_float(\"%s\") accepted\n", bad_floats[i]);
+            errors++;
+        }
+    }
+    printf("%d errors, parse_float() worst difference from strtof() %.1f ulp\n", errors, worst);
+    return errors;
+}
+
+int main(void) {
+    double start;
+    int32_t v;
+    float f;
+
+    make_strings();
+    int errors = check();
+
+    start = now_ns();
+    for (int l = 0; l < LOOPS; l++) for (int i = 0; i < COUNT; i++) sink += strtol(ints[i], NULL, 0);
+    double strtol_ns = (now_ns() - start) / (LOOPS * COUNT);
+    start = now_ns();
+    for (int l = 0; l < LOOPS; l++) for (int i = 0; i < COUNT; i++) { parse_int(ints[i], &v); sink += v; }
+    double int_ns = (now_ns() - start) / (LOOPS * COUNT);
+    start = now_ns();
+    for (int l = 0; l < LOOPS; l++) for (int i = 0; i < COUNT; i++) sink += (long)strtof(floats[i], NULL);
+    double strtof_ns = (now_ns() - start) / (LOOPS * COUNT);
+    start = now_ns();
+    for (int l = 0; l < LOOPS; l++) for (int i = 0; i < COUNT; i++) { parse_float(floats[i], &f); sink += (long)f; }
+    double float_ns = (now_ns() - start) / (LOOPS * COUNT);
+
+    printf("strtol      %6.1f ns    parse_int   %6.1f ns\n", strtol_ns, int_ns);
+    printf("strtof      %6.1f ns    parse_float %6.1f ns\n", strtof_ns, float_ns);
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,231 @@
+#!/usr/bin/env python3
+"""
+rpc_client.py - call command line commands over the binary RPC framing (src/rpc.c)
+
+Frame: 0x00, COBS(payload + CRC32 little-endian), 0x00
+    request:  sequence, command ID, typed arguments
+    response: sequence, status, typed values
+    INT: 0x01, int32 little-endian     STR: 0x02, length, characters
+
+Library use:
+    rpc = RpcClient('/dev/ttyACM0')
+    ret, output = rpc.call('add', 2, 3)
+
+Command line:
+    rpc_client.py <serial device> <command> [arguments...]    call a command, print its output
+    rpc_client.py <serial device> --loopback [count]           echo random arguments, time calls
+    rpc_client.py --selftest                                   check the framing code, no device
+
+Needs pyserial (pip install pyserial) for a device.
+"""
+
+import random
+import struct
+import sys
+import time
+import zlib
+
+TYPE_INT = 0x01
+TYPE_STR = 0x02
+ID_LIST = 0xFF
+ID_ECHO = 0xFE
+STATUS = {0: 'ok', 1: 'unknown command', 2: 'bad arguments'}
+
+
+class RpcError(Exception):
+    pass
+
+
+def cobs_encode(data):
+    out = bytearray()
+    block = bytearray()
+    for b in data:
+        if b == 0:
+            out += bytes([len(block) + 1]) + block
+            block = bytearray()
+        else:
+            block.append(b)
+            if len(block) == 254:
+                out += b'\xff' + block
+                block = bytearray()
+    out += bytes([len(block) + 1]) + block
+    return bytes(out)
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            raise RpcError('bad COBS frame')
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def frame(payload):
+    return b'\x00' + cobs_encode(payload + struct.pack('<I', zlib.crc32(payload))) + b'\x00'
+
+
+def unframe(encoded):
+    data = cobs_decode(encoded)
+    if len(data) < 6:
+        raise RpcError('short frame')
+    payload, crc = data[:-4], struct.unpack('<I', data[-4:])[0]
+    if zlib.crc32(payload) != crc:
+        raise RpcError('CRC error')
+    return payload
+
+
+def pack_values(values):
+    out = bytearray()
+    for v in values:
+        if isinstance(v, int):
+            out += struct.pack('<Bi', TYPE_INT, v)
+        else:
+            s = v.encode() if isinstance(v, str) else bytes(v)
+            out += struct.pack('<BB', TYPE_STR, len(s)) + s
+    return bytes(out)
+
+
+def unpack_values(data):
+    values = []
+    i = 0
+    while i < len(data):
+        if data[i] == TYPE_INT:
+            values.append(struct.unpack_from('<i', data, i + 1)[0])
+            i += 5
+        elif data[i] == TYPE_STR:
+            n = data[i + 1]
+            values.append(data[i + 2:i + 2 + n].decode(errors='replace'))
+            i += 2 + n
+        else:
+            raise RpcError('unknown value type 0x%02X' % data[i])
+    return values
+
+
+class RpcClient:
+    def __init__(self, device, baud=115200, timeout=2.0):
+        import serial
+        self.port = serial.Serial(device, baud, timeout=timeout)
+        self.seq = 0
+        self.ids = None
+
+    def request(self, cmd_id, *args):
+        """Send one request, return the response values"""
+        self.seq = (self.seq + 1) & 0xFF
+        self.port.write(frame(bytes([self.seq, cmd_id]) + pack_values(args)))
+        while True:
+            # Skip text output up to the opening 0x00, then read to the closing one
+            if self.port.read_until(b'\x00')[-1:] != b'\x00':
+                raise RpcError('timeout')
+            encoded = self.port.read_until(b'\x00')
+            if encoded[-1:] != b'\x00':
+                raise RpcError('timeout')
+            if len(encoded) == 1:
+                continue            # back to back delimiters
+            payload = unframe(encoded[:-1])
+            if payload[0] != self.seq:
+                continue            # stale response
+            if payload[1] != 0:
+                raise RpcError(STATUS.get(payload[1], 'status %d' % payload[1]))
+            return unpack_values(payload[2:])
+
+    def commands(self):
+        """Command name to ID map, in the firmware's command index order"""
+        if self.ids is None:
+            names = []
+            while True:
+                page = self.request(ID_LIST, len(names))
+                if not page:
+                    break
+                names += page
+            self.ids = {name: i for i, name in enumerate(names)}
+        return self.ids
+
+    def call(self, command, *args):
+        """Run a command, return (return value, text output)"""
+        ret, output = self.request(self.commands()[command], *args)
+        return ret, output
+
+    def echo(self, *args):
+        return self.request(ID_ECHO, *args)
+
+
+def random_args():
+    args = []
+    for _ in range(random.randint(0, 6)):
+        if random.random() < 0.5:
+            args.append(random.randint(-2**31, 2**31 - 1))
+        else:
+            # include 0x00 bytes so the COBS code blocks are exercised
+            args.append(bytes(random.randint(0, 255) for _ in range(random.randint(0, 30))))
+    return args
+
+
+def looks_typed(encoded):
+    """True if rpc_receive() would take the frame for a line typed after a stray 0x00"""
+    for i, b in enumerate(encoded):
+        if b in b'\r\n' and i >= 3:
+            return True
+        if not 0x20 <= b <= 0x7E:
+            return False
+    return False
+
+
+def selftest():
+    for n in (0, 1, 253, 254, 255, 600):
+        for data in (bytes(n), bytes(range(1, 256)) * 3, bytes(random.randint(0, 255) for _ in range(n))):
+            data = data[:n]
+            assert cobs_decode(cobs_encode(data)) == data
+            assert 0 not in cobs_encode(data)
+    for _ in range(1000):
+        args = random_args()
+        payload = bytes([7, ID_ECHO]) + pack_values(args)
+        assert unframe(frame(payload)[1:-1]) == payload
+        assert not looks_typed(frame(payload)[1:-1])
+        expected = [a if isinstance(a, int) else a.decode(errors='replace') for a in args]
+        assert unpack_values(pack_values(args)) == expected
+    for seq in range(256):
+        for cmd_id in range(256):
+            assert not looks_typed(frame(bytes([seq, cmd_id]) + pack_values(['A' * 40 + '\r']))[1:-1])
+    print('selftest passed')
+
+
+def loopback(rpc, count):
+    start = time.monotonic()
+    for _ in range(count):
+        args = random_args()
+        expected = [a if isinstance(a, int) else a.decode(errors='replace') for a in args]
+        if rpc.echo(*args) != expected:
+            raise RpcError('echo mismatch for %r' % (args,))
+    elapsed = time.monotonic() - start
+    print('%d echo calls, %.2f ms/call' % (count, 1000 * elapsed / count))
+
+
+def main():
+    if len(sys.argv) > 1 and sys.argv[1] == '--selftest':
+        selftest()
+        return
+    if len(sys.argv) < 3:
+        sys.exit(__doc__)
+    rpc = RpcClient(sys.argv[1])
+    if sys.argv[2] == '--loopback':
+        loopback(rpc, int(sys.argv[3]) if len(sys.argv) > 3 else 100)
+        return
+    args = []
+    for a in sys.argv[3:]:
+        try:
+            args.append(int(a, 0))
+        except ValueError:
+            args.append(a)
+    ret, output = rpc.call(sys.argv[2], *args)
+    sys.stdout.write(output)
+    print('returned %d' % ret)
+
+
+if __name__ == '__main__':
+    main()
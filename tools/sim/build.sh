@@ -0,0 +1,15 @@
+#!/bin/sh
+# Build the host simulation of the firmware (see sim.c) as tools/sim/sim.
+# Usage: tools/sim/build.sh [extra gcc options, e.g. -O0 or -fsanitize=address]
+# -no-pie keeps the LOG_DICT() format string IDs and %s addresses the same as in the ELF file,
+# for tools/log_decode.py.
+cd "$(dirname "$0")/../.." || exit 1
+CFG=src/config/default
+PLIB=$CFG/peripheral
+exec gcc -std=gnu99 -O2 -g -Wall -no-pie -D__SAME51J20A__ -Dmain=firmware_main \
+    -Itools/sim -Isrc -I$CFG -Isrc/packs/ATSAME51J20A_DFP "$@" -o tools/sim/sim \
+    tools/sim/sim.c \
+    src/main.c src/command_line.c src/logger.c src/scheduler.c src/uart.c src/rpc.c src/crc.c \
+    src/job.c src/parse.c src/bench.c src/timebase.c src/swtimer.c src/power.c \
+    $PLIB/sercom/usart/plib_sercom5_usart.c $PLIB/tc/plib_tc0.c $PLIB/tc/plib_tc2.c \
+    $PLIB/systick/plib_systick.c
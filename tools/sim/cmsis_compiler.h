@@ -0,0 +1,24 @@
+/**************************************************************************************************
+cmsis_compiler.h
+Host simulation stand-in for the CMSIS compiler header: attributes only, no Arm intrinsics
+(core_cm4.h in this directory has the simulated ones)
+
+**************************************************************************************************/
+
+#ifndef SIM_CMSIS_COMPILER_H
+#define SIM_CMSIS_COMPILER_H
+
+#define __ASM                   __asm
+#define __INLINE                inline
+#define __STATIC_INLINE         static inline
+#define __STATIC_FORCEINLINE    __attribute__((always_inline)) static inline
+#define __NO_RETURN             __attribute__((__noreturn__))
+#define __USED                  __attribute__((used))
+#define __WEAK                  __attribute__((weak))
+#define __PACKED                __attribute__((packed, aligned(1)))
+#define __PACKED_STRUCT         struct __attribute__((packed, aligned(1)))
+#define __ALIGNED(x)            __attribute__((aligned(x)))
+#define __RESTRICT              __restrict
+#define __COMPILER_BARRIER()    __asm volatile("" ::: "memory")
+
+#endif // SIM_CMSIS_COMPILER_H
@@ -0,0 +1,172 @@
+/**************************************************************************************************
+core_cm4.h
+Host simulation stand-in for the CMSIS Cortex-M4 core header
+
+Found before the real one on the include path.  SysTick, SCB, DWT and CoreDebug point into the simulated
+register file (sim.h), and the intrinsics the firmware uses work on the simulated PRIMASK, IPSR and
+exclusive monitor.  Only the parts the firmware and its plibs use are here.
+
+**************************************************************************************************/
+
+#ifndef SIM_CORE_CM4_H
+#define SIM_CORE_CM4_H
+
+#include <stdint.h>
+#include "cmsis_compiler.h"
+#include "sim.h"
+
+#define __I     volatile const
+#define __O     volatile
+#define __IO    volatile
+#define __IM    volatile const
+#define __OM    volatile
+#define __IOM   volatile
+
+// SysTick
+typedef struct {
+    __IOM uint32_t CTRL;
+    __IOM uint32_t LOAD;
+    __IOM uint32_t VAL;
+    __IM  uint32_t CALIB;
+} SysTick_Type;
+
+#define SysTick_CTRL_ENABLE_Pos         0U
+#define SysTick_CTRL_ENABLE_Msk         (1UL << SysTick_CTRL_ENABLE_Pos)
+#define SysTick_CTRL_TICKINT_Pos        1U
+#define SysTick_CTRL_TICKINT_Msk        (1UL << SysTick_CTRL_TICKINT_Pos)
+#define SysTick_CTRL_CLKSOURCE_Pos      2U
+#define SysTick_CTRL_CLKSOURCE_Msk      (1UL << SysTick_CTRL_CLKSOURCE_Pos)
+#define SysTick_CTRL_COUNTFLAG_Pos      16U
+#define SysTick_CTRL_COUNTFLAG_Msk      (1UL << SysTick_CTRL_COUNTFLAG_Pos)
+#define SysTick_LOAD_RELOAD_Msk         0xFFFFFFUL
+#define SysTick_VAL_CURRENT_Msk         0xFFFFFFUL
+
+// Data Watchpoint and Trace, the counters only
+typedef struct {
+    __IOM uint32_t CTRL;
+    __IOM uint32_t CYCCNT;
+    __IOM uint32_t CPICNT;
+    __IOM uint32_t EXCCNT;
+    __IOM uint32_t SLEEPCNT;
+    __IOM uint32_t LSUCNT;
+    __IOM uint32_t FOLDCNT;
+    __IM  uint32_t PCSR;
+} DWT_Type;
+
+#define DWT_CTRL_CYCCNTENA_Pos          0U
+#define DWT_CTRL_CYCCNTENA_Msk          (1UL << DWT_CTRL_CYCCNTENA_Pos)
+
+typedef struct {
+    __IOM uint32_t DHCSR;
+    __OM  uint32_t DCRSR;
+    __IOM uint32_t DCRDR;
+    __IOM uint32_t DEMCR;
+} CoreDebug_Type;
+
+#define CoreDebug_DEMCR_TRCENA_Pos      24U
+#define CoreDebug_DEMCR_TRCENA_Msk      (1UL << CoreDebug_DEMCR_TRCENA_Pos)
+
+// System Control Block, ICSR only
+typedef struct {
+    __IM  uint32_t CPUID;
+    __IOM uint32_t ICSR;
+} SCB_Type;
+
+#define SCB_ICSR_PENDSTSET_Pos          26U
+#define SCB_ICSR_PENDSTSET_Msk          (1UL << SCB_ICSR_PENDSTSET_Pos)
+
+#define SCB         ((SCB_Type *)(sim_io + SIM_SCB))
+#define SysTick     ((SysTick_Type *)(sim_io + SIM_SYSTICK))
+#define DWT         ((DWT_Type *)(sim_io + SIM_DWT))
+#define CoreDebug   ((CoreDebug_Type *)(sim_io + SIM_COREDEBUG))
+
+// Interrupt masking and sleep
+__STATIC_INLINE void __disable_irq(void) {
+    sim_primask = 1U;
+    __COMPILER_BARRIER();
+}
+
+__STATIC_INLINE void __enable_irq(void) {
+    __COMPILER_BARRIER();
+    sim_enable_irq();
+}
+
+__STATIC_INLINE uint32_t __get_PRIMASK(void) {
+    return sim_primask;
+}
+
+__STATIC_INLINE void __set_PRIMASK(uint32_t priMask) {
+    if (priMask & 1U) __disable_irq();
+    else __enable_irq();
+}
+
+__STATIC_INLINE uint32_t __get_IPSR(void) {
+    return sim_ipsr();
+}
+
+__STATIC_INLINE void __WFI(void) {
+    sim_wfi();
+}
+
+__STATIC_INLINE void __NOP(void) {
+}
+
+__STATIC_INLINE void __DMB(void) {
+    __sync_synchronize();
+}
+
+__STATIC_INLINE void __DSB(void) {
+    __sync_synchronize();
+}
+
+__STATIC_INLINE void __ISB(void) {
+    __sync_synchronize();
+}
+
+// Exclusive access: the monitor is lost if a handler runs between the load and the store
+__STATIC_INLINE uint32_t __LDREXW(volatile uint32_t *addr) {
+    sim_exclusive = 1U;
+    __COMPILER_BARRIER();
+    return *addr;
+}
+
+// STREX is one instruction, so no handler may run between the monitor check and the store:
+// PRIMASK holds the SIGALRM interrupts off meanwhile, the next one runs any that came due
+__STATIC_INLINE uint32_t __STREXW(uint32_t value, volatile uint32_t *addr) {
+    uint32_t primask = sim_primask;
+    uint32_t failed = 1U;
+    sim_primask = 1U;
+    __COMPILER_BARRIER();
+    if (sim_exclusive != 0U) {
+        sim_exclusive = 0U;
+        *addr = value;
+        failed = 0U;
+    }
+    __COMPILER_BARRIER();
+    sim_primask = primask;
+    return failed;
+}
+
+__STATIC_INLINE void __CLREX(void) {
+    sim_exclusive = 0U;
+}
+
+// NVIC: every interrupt is enabled, priorities are not simulated
+__STATIC_INLINE void NVIC_EnableIRQ(IRQn_Type IRQn) {
+    (void)IRQn;
+}
+
+__STATIC_INLINE void NVIC_DisableIRQ(IRQn_Type IRQn) {
+    (void)IRQn;
+}
+
+__STATIC_INLINE void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority) {
+    (void)IRQn;
+    (void)priority;
+}
+
+__NO_RETURN __STATIC_INLINE void NVIC_SystemReset(void) {
+    sim_reset();
+}
+
+#endif // SIM_CORE_CM4_H
@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+"""
+log_roundtrip.py - dictionary logging round trip through the host simulation
+
+Runs "logdict" in tools/sim/sim, decodes the output with tools/log_decode.py against the
+simulation's own ELF file, and compares the records with the text cl_logdict() (src/logger.c)
+logs.  Exits non-zero on a difference.  Also shows how many times smaller the records are than
+the text they decode to.
+
+Usage:
+    tools/sim/build.sh && tools/sim/log_roundtrip.py [path/to/sim]
+"""
+
+import io
+import os
+import re
+import subprocess
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.dirname(HERE))
+import log_decode  # noqa: E402  (tools/log_decode.py)
+
+# cl_logdict()'s records, in order
+EXPECTED = [
+    'Dictionary log test',
+    'record 1 of 3, value 0xDEADBEEF',
+    'record 2 of 3, value 0xDEADBEF0',
+    'record 3 of 3, value 0xDEADBEF1',
+    'string arguments are read from the ELF, c',
+]
+
+RECORD = re.compile(r'^\[(\d+)\.(\d{6})\] (.*)$')
+RECORD_BYTES = re.compile(r'^dictionary records: (\d+) bytes')
+
+
+def main():
+    sim = sys.argv[1] if len(sys.argv) > 1 else os.path.join(HERE, 'sim')
+    run = subprocess.run([sim, '-f'], input=b'logdict\r', stdout=subprocess.PIPE, check=True)
+
+    text = io.StringIO()
+    log_decode.decode(log_decode.Elf(sim), io.BytesIO(run.stdout), text)
+    records = []
+    record_bytes = text_bytes = 0
+    for line in text.getvalue().splitlines():
+        match = RECORD.match(line)
+        if match:
+            records.append((int(match.group(1)) * 1000000 + int(match.group(2)), match.group(3)))
+            text_bytes += len(line) + 1
+        match = RECORD_BYTES.match(line)
+        if match:
+            record_bytes = int(match.group(1))
+
+    ok = [text for _, text in records] == EXPECTED
+    times = [us for us, _ in records]
+    if times != sorted(times):
+        ok = False
+        print('timestamps out of order: %s' % times)
+    for i in range(max(len(records), len(EXPECTED))):
+        got = records[i][1] if i < len(records) else '<missing>'
+        want = EXPECTED[i] if i < len(EXPECTED) else '<none>'
+        print('%s %s' % ('ok  ' if got == want else 'FAIL', got if got == want else
+                         '%r, expected %r' % (got, want)))
+    if record_bytes:
+        print('%d record bytes for %d bytes of text, %.1fx smaller' %
+              (record_bytes, text_bytes, text_bytes / record_bytes))
+    print('log round trip: %s' % ('passed' if ok else 'FAILED'))
+    return 0 if ok else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
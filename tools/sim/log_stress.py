@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+"""
+log_stress.py - multi-producer logging check through the host simulation
+
+Runs "logstress" in tools/sim/sim: for LOGSTRESS_MS the SysTick interrupt logs "isr N" with
+log_msg() and "isr deferred N" with LOG_DEFER() every millisecond, while the main loop logs
+"main loop message N" as fast as it can (cl_logstress() in src/logger.c).  Every line of output
+must be one whole message from one producer, each producer's numbers must only go up, and the
+numbers missing in between must add up to the "dropped" count the command reports.  Exits
+non-zero otherwise.
+
+Usage:
+    tools/sim/build.sh && tools/sim/log_stress.py [path/to/sim]
+"""
+
+import os
+import re
+import subprocess
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+PRODUCERS = [
+    ('isr', re.compile(r'^isr (\d+)$')),
+    ('isr deferred', re.compile(r'^\[\d+\.\d{6}\] isr deferred (\d+)$')),
+    ('main loop', re.compile(r'^main loop message (\d+)$')),
+]
+SUMMARY = re.compile(r'^ISR messages: (\d+), main loop messages: (\d+), dropped: (\d+)$')
+
+
+def main():
+    sim = sys.argv[1] if len(sys.argv) > 1 else os.path.join(HERE, 'sim')
+    run = subprocess.run([sim, '-t', '2000'], input=b'logstress\r', stdout=subprocess.PIPE, check=True)
+    lines = run.stdout.decode('latin-1').replace('\r', '').split('\n')
+
+    try:
+        start = next(i for i, line in enumerate(lines) if line.endswith('logstress')) + 1
+        end = next(i for i in range(start, len(lines)) if SUMMARY.match(lines[i]))
+    except StopIteration:
+        print('no "logstress" output')
+        return 1
+    isr_total, main_total, dropped = (int(n) for n in SUMMARY.match(lines[end]).groups())
+    sent = {'isr': isr_total // 2, 'isr deferred': isr_total // 2, 'main loop': main_total}
+
+    ok = True
+    seen = {name: [] for name, _ in PRODUCERS}
+    for number, line in enumerate(lines[start:end], start + 1):
+        if line == '':
+            continue    # the blank line before the summary
+        for name, pattern in PRODUCERS:
+            match = pattern.match(line)
+            if match:
+                seen[name].append(int(match.group(1)))
+                break
+        else:
+            ok = False
+            print('line %d interleaved or truncated: %r' % (number, line))
+
+    missing = 0
+    for name, _ in PRODUCERS:
+        numbers = seen[name]
+        previous = -1
+        for n in numbers:
+            if n <= previous:
+                ok = False
+                print('%s: %d after %d' % (name, n, previous))
+            previous = n
+        if numbers and numbers[-1] >= sent[name]:
+            ok = False
+            print('%s: %d, but only %d sent' % (name, numbers[-1], sent[name]))
+        lost = sent[name] - len(set(numbers))
+        missing += lost
+        print('%-12s sent %6d, received %6d, missing %6d' % (name, sent[name], len(numbers), lost))
+
+    if missing != dropped:
+        ok = False
+        print('%d messages missing, but %d reported dropped' % (missing, dropped))
+    print('log stress: %s' % ('passed' if ok else 'FAILED'))
+    return 0 if ok else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
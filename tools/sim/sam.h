@@ -0,0 +1,7 @@
+/**************************************************************************************************
+sam.h
+Host simulation stand-in for the XC32 device selection header
+
+**************************************************************************************************/
+
+#include "same51j20a.h"
@@ -0,0 +1,27 @@
+/**************************************************************************************************
+same51j20a.h
+Host simulation device header: the real DFP header, with the simulated peripherals moved into the
+simulated register file (sim.h).  Found before the DFP on the include path.
+
+**************************************************************************************************/
+
+#ifndef SIM_SAME51J20A_H
+#define SIM_SAME51J20A_H
+
+#include "../../src/packs/ATSAME51J20A_DFP/same51j20a.h"
+
+#undef SERCOM5_REGS
+#undef TC0_REGS
+#undef TC2_REGS
+#undef DSU_REGS
+#undef PAC_REGS
+#undef PORT_REGS
+
+#define SERCOM5_REGS    ((sercom_registers_t *)(sim_io + SIM_SERCOM5))
+#define TC0_REGS        ((tc_registers_t *)(sim_io + SIM_TC0))
+#define TC2_REGS        ((tc_registers_t *)(sim_io + SIM_TC2))
+#define DSU_REGS        ((dsu_registers_t *)(sim_io + SIM_DSU))
+#define PAC_REGS        ((pac_registers_t *)(sim_io + SIM_PAC))
+#define PORT_REGS       ((port_registers_t *)(sim_io + SIM_PORT))
+
+#endif // SIM_SAME51J20A_H
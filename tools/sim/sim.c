@@ -0,0 +1,1203 @@
+/**************************************************************************************************
+sim.c
+Host (Linux x86-64) simulation of the command line firmware
+
+Builds the real sources - main.c, the command line, logger, scheduler, RPC, jobs and the SERCOM5,
+TC0, TC2 and SysTick plibs - for the host and runs them against simulated peripheral registers, so
+changes can be measured and regression tested without a board:
+    tools/sim/build.sh                          build tools/sim/sim
+    printf 'version\r' | tools/sim/sim          type the input at the command line, output on stdout
+    tools/sim/sim                               interactive on a terminal, Ctrl-] quits
+    tools/sim/sim -p                            serve a pseudo terminal (name on stderr) for
+                                                rpc_client.py, baud_test.py or a terminal program
+Options:
+    -e          measure echo latency, from each received printable byte to the start of its echo
+                on the transmit line, and print a summary on exit
+    -f          fast: no baud rate pacing of the simulated line
+    -t <ms>     with piped input, quit after end of input and <ms> without output (default 200)
+    -v          print register access, interrupt and byte counts on exit
+
+Registers
+The register blocks (sim.h) live in a memfd mapped twice: sim_io, with no access, is where the
+firmware's SERCOM5_REGS, TC0_REGS, SysTick, DWT etc. point, and regs, read/write, is the simulator's
+view.  Every register access by the firmware faults.  The SIGSEGV handler brings the register in
+regs up to date for a read (the TC0 count, SERCOM5 flags, received DATA ...), opens sim_io and
+single steps the instruction with the trap flag.  The SIGTRAP handler closes sim_io again and acts
+on a write: set/clear register pairs, write-one-to-clear flags, a byte written to DATA starts
+transmitting, and so on.  So the plibs run unmodified, at a few microseconds per register access.
+
+Interrupts are taken between instructions like the real thing, if PRIMASK is clear and no handler
+is running (handlers don't nest, priorities are not simulated): after a register access, on
+__enable_irq(), and from a 50 us interval timer (SIGALRM) so code spinning on RAM is interrupted
+too.
+
+Peripherals
+    SERCOM5     USART: DATA, INTENSET/CLR, INTFLAG, STATUS, CTRLA/B and BAUD.  Bytes take their
+                time on the line at the programmed baud rate and frame format (not with -f).  A
+                received byte waits while DATA is unread, so the receiver never overruns.
+    TC0, TC2    COUNT from the host clock at TCn_TimerFrequencyGet(), CC0 as TOP in MFRQ/MPWM,
+                overflow and compare match flags and interrupts, CTRLB commands, enable and
+                software reset.
+    SysTick     CTRL, LOAD, VAL and the tick interrupt, at the 120 MHz CPU clock.  LOAD is taken
+                at each reload, so a restart can have a short first tick.  Ticks while TICKINT is
+                clear don't interrupt.  SCB ICSR PENDSTSET.
+    DWT         CYCCNT counts 120 MHz of host time.
+    DSU         DID reads as the ATSAME51J20A.  The CRC engine is not simulated (host builds of
+                crc.c use the software CRC).
+    DMAC        Function level, replacing plib_dmac.c: a transfer to SERCOM5 DATA feeds the
+                transmitter as it empties and a circular transfer from DATA takes received bytes.
+                The completion callback runs as the channel's interrupt.
+    PORT, PAC   Plain memory.
+Input is held back until the firmware first sleeps, as if typed once it has started.
+NVIC_SystemReset() runs the simulator again from the start, keeping the unread input.
+The serial number words read by "id" are mapped at their real addresses.
+
+**************************************************************************************************/
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+
+#include "definitions.h"
+#include "interrupts.h"
+#include "sim.h"
+
+#undef main                     // main.c is built with -Dmain=firmware_main
+int firmware_main(void);
+
+#define CPU_HZ          120000000ULL
+#define SERCOM5_REF_HZ  60000000ULL     // SERCOM5_USART_FrequencyGet()
+#define NS_PER_S        1000000000ULL
+#define DSU_DID_SAME51J20A  0x61810304U
+#define RX_POLL_NS      100000ULL       // look for more input at most this often
+#define FLUSH_NS        10000000ULL     // write out transmitted bytes at least this often
+#define KEY_QUIT        0x1D            // Ctrl-] on an interactive terminal
+#define ALARM_US        50              // interval timer for interrupts between register accesses
+#define X86_TRAP_FLAG   0x100
+#define X86_PF_WRITE    0x2             // page fault error code: write access
+
+_Static_assert(sizeof(sercom_registers_t) <= SIM_TC0 - SIM_SERCOM5, "SERCOM5 block too small");
+_Static_assert(sizeof(tc_registers_t) <= SIM_TC2 - SIM_TC0, "TC block too small");
+_Static_assert(sizeof(pac_registers_t) <= SIM_PORT - SIM_PAC, "PAC block too small");
+_Static_assert(sizeof(port_registers_t) <= SIM_SYSTICK - SIM_PORT, "PORT block too small");
+_Static_assert(sizeof(dsu_registers_t) <= SIM_IO_SIZE - SIM_DSU, "DSU block too small");
+
+uint8_t *sim_io;                        // the firmware's view of the registers, no access
+volatile uint32_t sim_primask;
+volatile uint32_t sim_exclusive;
+static uint8_t *regs;                   // the simulator's view
+
+static bool fast;
+static bool verbose;
+static bool echo_timing;
+static uint64_t idle_exit_ns = 200000000ULL;
+static char **sim_argv;
+static volatile sig_atomic_t sim_busy;  // simulator code running for the firmware, no SIGALRM
+static volatile sig_atomic_t stepping;  // between the SIGSEGV and SIGTRAP of a register access
+static struct timespec t0;
+
+static struct {
+    uint64_t accesses;
+    uint64_t interrupts;
+    uint64_t tx_bytes;
+    uint64_t rx_bytes;
+    uint64_t sleep_ns;
+} stats;
+
+//=================================================================================================
+// Time
+//=================================================================================================
+
+// Nanoseconds since the simulated power-on
+static uint64_t now_ns(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)((int64_t)(t.tv_sec - t0.tv_sec) * (int64_t)NS_PER_S + (t.tv_nsec - t0.tv_nsec));
+}
+
+//=================================================================================================
+// Host side of the serial line: stdin/stdout or a pseudo terminal
+//=================================================================================================
+
+static int in_fd = STDIN_FILENO;
+static int out_fd = STDOUT_FILENO;
+static bool in_tty;                     // interactive terminal, in raw mode
+static bool in_pty;                     // -p, the line never ends
+static struct termios tty_saved;
+static uint8_t in_buf[256];
+static size_t in_pos, in_len;
+static bool in_eof;
+static bool booted;                     // the firmware has gone to sleep once, input may start
+static uint64_t in_next_poll;
+static uint8_t out_buf[4096];
+static size_t out_len;
+static uint64_t out_flushed;
+static uint64_t line_active;            // last time a byte went either way
+
+static void out_flush(void) {
+    size_t done = 0;
+    while (done < out_len) {
+        ssize_t n = write(out_fd, &out_buf[done], out_len - done);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            break;                      // nobody listening, drop it as the wire would
+        }
+        done += (size_t)n;
+    }
+    out_len = 0;
+    out_flushed = now_ns();
+}
+
+static void out_byte(uint8_t c) {
+    if (out_len == sizeof(out_buf)) out_flush();
+    out_buf[out_len++] = c;
+}
+
+static void tty_restore(void) {
+    tcsetattr(in_fd, TCSANOW, &tty_saved);
+}
+
+static void echo_report(void);
+
+static void sim_exit(void) {
+    out_flush();
+    echo_report();
+    if (verbose) {
+        fprintf(stderr, "sim: %llu register accesses, %llu interrupts, %llu bytes TX, %llu bytes RX, "
+                "%llu ms asleep\n", (unsigned long long)stats.accesses, (unsigned long long)stats.interrupts,
+                (unsigned long long)stats.tx_bytes, (unsigned long long)stats.rx_bytes,
+                (unsigned long long)(stats.sleep_ns / 1000000ULL));
+    }
+    exit(0);
+}
+
+// Next input byte, if one has arrived
+static bool in_byte(uint64_t t, uint8_t *c) {
+    if (!booted) return false;
+    if (in_pos == in_len) {
+        if (in_eof || t < in_next_poll) return false;
+        struct pollfd p = {in_fd, POLLIN, 0};
+        ssize_t n = 0;
+        if (poll(&p, 1, 0) > 0 && (p.revents & POLLIN)) n = read(in_fd, in_buf, sizeof(in_buf));
+        if (n == 0 && (p.revents & (POLLIN | POLLHUP)) && !in_pty) in_eof = true;
+        if (n <= 0) {
+            in_next_poll = t + RX_POLL_NS;
+            return false;
+        }
+        in_pos = 0;
+        in_len = (size_t)n;
+    }
+    *c = in_buf[in_pos++];
+    if (in_tty && *c == KEY_QUIT) sim_exit();
+    return true;
+}
+
+//=================================================================================================
+// Echo latency (-e)
+//=================================================================================================
+
+// Printable bytes received and not echoed yet, oldest first.  A transmitted byte is the echo of
+// the oldest one it matches; older ones it passes over were not echoed (pasted too fast, or taken
+// by a line editing key) and are dropped.
+#define ECHO_PENDING    1024
+#define ECHO_SAMPLES    65536
+
+static struct {
+    uint8_t byte[ECHO_PENDING];
+    uint64_t rx_ns[ECHO_PENDING];
+    size_t pending;
+    uint32_t latency_ns[ECHO_SAMPLES];
+    size_t samples;
+    uint64_t dropped;
+} echo;
+
+static void echo_rx(uint8_t c, uint64_t t) {
+    if (!echo_timing || c < 0x20 || c > 0x7E) return;
+    if (echo.pending == ECHO_PENDING) {
+        memmove(&echo.byte[0], &echo.byte[1], ECHO_PENDING - 1);
+        memmove(&echo.rx_ns[0], &echo.rx_ns[1], (ECHO_PENDING - 1) * sizeof(echo.rx_ns[0]));
+        echo.pending--;
+        echo.dropped++;
+    }
+    echo.byte[echo.pending] = c;
+    echo.rx_ns[echo.pending++] = t;
+}
+
+static void echo_tx(uint8_t c, uint64_t t) {
+    size_t i = 0;
+    if (!echo_timing) return;
+    while (i < echo.pending && echo.byte[i] != c) i++;
+    if (i == echo.pending) return;              // output, not an echo
+    if (echo.samples < ECHO_SAMPLES) echo.latency_ns[echo.samples++] = (uint32_t)(t - echo.rx_ns[i]);
+    echo.dropped += i;
+    i++;
+    memmove(&echo.byte[0], &echo.byte[i], echo.pending - i);
+    memmove(&echo.rx_ns[0], &echo.rx_ns[i], (echo.pending - i) * sizeof(echo.rx_ns[0]));
+    echo.pending -= i;
+}
+
+static int echo_compare(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void echo_report(void) {
+    if (!echo_timing) return;
+    if (echo.samples == 0) {
+        fprintf(stderr, "sim: echo latency: no echoed bytes\n");
+        return;
+    }
+    uint64_t sum = 0;
+    for (size_t i = 0; i < echo.samples; i++) sum += echo.latency_ns[i];
+    qsort(echo.latency_ns, echo.samples, sizeof(echo.latency_ns[0]), echo_compare);
+    fprintf(stderr, "sim: echo latency over %zu bytes (%llu not echoed): min %.1f us, mean %.1f us, "
+            "median %.1f us, p99 %.1f us, max %.1f us\n", echo.samples, (unsigned long long)echo.dropped,
+            echo.latency_ns[0] / 1000.0, (double)sum / (double)echo.samples / 1000.0,
+            echo.latency_ns[echo.samples / 2] / 1000.0,
+            echo.latency_ns[(echo.samples * 99 + 99) / 100 - 1] / 1000.0,
+            echo.latency_ns[echo.samples - 1] / 1000.0);
+}
+
+//=================================================================================================
+// DMAC, function level (replaces plib_dmac.c)
+//=================================================================================================
+
+#define SIM_DMAC_CHANNELS   2
+
+static struct {
+    DMAC_CHANNEL_CALLBACK callback;
+    uintptr_t context;
+    bool busy;
+    bool circular;
+    bool complete;                      // transfer done, interrupt pending
+    const uint8_t *src;
+    uint8_t *dst;
+    size_t size;
+    size_t count;
+} dmac[SIM_DMAC_CHANNELS];
+
+static bool is_sercom5_data(const void *p) {
+    return p == (const void *)&SERCOM5_REGS->USART_INT.SERCOM_DATA;
+}
+
+void DMAC_Initialize(void) {
+    memset(dmac, 0, sizeof(dmac));
+}
+
+void DMAC_ChannelCallbackRegister(DMAC_CHANNEL channel, const DMAC_CHANNEL_CALLBACK callback, const uintptr_t context) {
+    dmac[channel].callback = callback;
+    dmac[channel].context = context;
+}
+
+static bool dmac_start(DMAC_CHANNEL channel, const void *srcAddr, const void *destAddr, size_t blockSize, bool circular) {
+    if (dmac[channel].busy || blockSize == 0U || blockSize > 0xFFFFU) return false;
+    sim_busy++;
+    dmac[channel].src = srcAddr;
+    dmac[channel].dst = (uint8_t *)destAddr;
+    dmac[channel].size = blockSize;
+    dmac[channel].count = 0;
+    dmac[channel].circular = circular;
+    dmac[channel].busy = true;
+    sim_busy--;
+    return true;
+}
+
+bool DMAC_ChannelTransfer(DMAC_CHANNEL channel, const void *srcAddr, const void *destAddr, size_t blockSize) {
+    return dmac_start(channel, srcAddr, destAddr, blockSize, false);
+}
+
+bool DMAC_ChannelCircularTransfer(DMAC_CHANNEL channel, const void *srcAddr, const void *destAddr, size_t blockSize) {
+    return dmac_start(channel, srcAddr, destAddr, blockSize, true);
+}
+
+bool DMAC_ChannelIsBusy(DMAC_CHANNEL channel) {
+    return dmac[channel].busy;
+}
+
+uint16_t DMAC_ChannelGetTransferredCount(DMAC_CHANNEL channel) {
+    size_t count = dmac[channel].count;
+    return (uint16_t)(dmac[channel].circular ? count % dmac[channel].size : count);
+}
+
+void DMAC_ChannelDisable(DMAC_CHANNEL channel) {
+    dmac[channel].busy = false;
+}
+
+// The channel moving memory to SERCOM5 DATA, or -1
+static int dmac_tx_channel(void) {
+    for (int ch = 0; ch < SIM_DMAC_CHANNELS; ch++) {
+        if (dmac[ch].busy && is_sercom5_data(dmac[ch].dst)) return ch;
+    }
+    return -1;
+}
+
+// The channel moving SERCOM5 DATA to memory, or -1
+static int dmac_rx_channel(void) {
+    for (int ch = 0; ch < SIM_DMAC_CHANNELS; ch++) {
+        if (dmac[ch].busy && is_sercom5_data(dmac[ch].src)) return ch;
+    }
+    return -1;
+}
+
+// One beat: move a byte, and finish the block unless circular
+static void dmac_beat(int ch) {
+    if (++dmac[ch].count == dmac[ch].size && !dmac[ch].circular) {
+        dmac[ch].busy = false;
+        dmac[ch].complete = true;
+    }
+}
+
+//=================================================================================================
+// SERCOM5 USART
+//=================================================================================================
+
+#define SERCOM_REG(field)   (SIM_SERCOM5 + offsetof(sercom_registers_t, USART_INT.field))
+
+static sercom_usart_int_registers_t *sercom;    // simulator's view
+
+static struct {
+    uint8_t inten;
+    uint8_t intflag;                    // DRE and TXC are recomputed, the rest set and cleared
+    uint16_t status;
+    uint16_t rx_data;
+    bool tx_shifting;                   // a byte is in the shift register
+    uint64_t tx_shift_end;              // when it has gone
+    bool tx_buffered;                   // and another waits in DATA
+    uint16_t tx_buf;
+    uint64_t rx_next;                   // earliest end of the next received byte
+} uart;
+
+// Time for one frame on the line at the programmed baud rate
+static uint64_t uart_frame_ns(void) {
+    if (fast) return 0;
+    uint32_t ctrla = sercom->SERCOM_CTRLA;
+    uint32_t ctrlb = sercom->SERCOM_CTRLB;
+    uint32_t sampr = (ctrla & SERCOM_USART_INT_CTRLA_SAMPR_Msk) >> SERCOM_USART_INT_CTRLA_SAMPR_Pos;
+    uint32_t samples = sampr < 2U ? 16U : (sampr < 4U ? 8U : 3U);
+    uint32_t baud_reg = sercom->SERCOM_BAUD;
+    double baud;
+    if (sampr & 1U) {   // fractional
+        double div = (double)(baud_reg & 0x1FFFU) + (double)(baud_reg >> 13) / 8.0;
+        baud = div > 0.0 ? (double)SERCOM5_REF_HZ / (samples * div) : 0.0;
+    } else {            // arithmetic
+        baud = (double)SERCOM5_REF_HZ * (65536.0 - baud_reg) / (65536.0 * samples);
+    }
+    if (baud <= 0.0) return 0;
+
+    uint32_t chsize = (ctrlb & SERCOM_USART_INT_CTRLB_CHSIZE_Msk) >> SERCOM_USART_INT_CTRLB_CHSIZE_Pos;
+    uint32_t bits = 1U + (chsize == 1U ? 9U : (chsize >= 5U ? chsize : 8U));
+    if (((ctrla & SERCOM_USART_INT_CTRLA_FORM_Msk) >> SERCOM_USART_INT_CTRLA_FORM_Pos) == 1U) bits++;
+    bits += (ctrlb & SERCOM_USART_INT_CTRLB_SBMODE_Msk) ? 2U : 1U;
+    return (uint64_t)((double)bits * (double)NS_PER_S / baud);
+}
+
+static bool uart_tx_enabled(void) {
+    return (sercom->SERCOM_CTRLA & SERCOM_USART_INT_CTRLA_ENABLE_Msk) &&
+           (sercom->SERCOM_CTRLB & SERCOM_USART_INT_CTRLB_TXEN_Msk);
+}
+
+static bool uart_rx_enabled(void) {
+    return (sercom->SERCOM_CTRLA & SERCOM_USART_INT_CTRLA_ENABLE_Msk) &&
+           (sercom->SERCOM_CTRLB & SERCOM_USART_INT_CTRLB_RXEN_Msk);
+}
+
+static void uart_shift(uint16_t c, uint64_t start) {
+    out_byte((uint8_t)c);
+    echo_tx((uint8_t)c, start);
+    stats.tx_bytes++;
+    line_active = start;
+    uart.tx_shifting = true;
+    uart.tx_shift_end = start + uart_frame_ns();
+}
+
+// DATA written, by the CPU or the DMAC
+static void uart_data_write(uint16_t c, uint64_t t) {
+    uart.intflag &= (uint8_t)~SERCOM_USART_INT_INTFLAG_TXC_Msk;
+    if (!uart.tx_shifting) {
+        uart_shift(c, t);
+    } else if (!uart.tx_buffered) {
+        uart.tx_buffered = true;
+        uart.tx_buf = c;
+    }   // else written while DRE was clear, lost as on the chip
+}
+
+static void uart_tx_update(uint64_t t) {
+    while (true) {
+        if (uart.tx_shifting && t >= uart.tx_shift_end) {
+            uart.tx_shifting = false;
+            if (uart.tx_buffered) {
+                uart.tx_buffered = false;
+                uart_shift(uart.tx_buf, uart.tx_shift_end);
+                continue;
+            }
+            uart.intflag |= SERCOM_USART_INT_INTFLAG_TXC_Msk;
+        }
+        int ch = dmac_tx_channel();
+        if (uart.tx_buffered || ch < 0 || !uart_tx_enabled()) break;
+        uart_data_write(dmac[ch].src[dmac[ch].count], t);
+        dmac_beat(ch);
+    }
+    if (uart.tx_buffered) uart.intflag &= (uint8_t)~SERCOM_USART_INT_INTFLAG_DRE_Msk;
+    else uart.intflag |= SERCOM_USART_INT_INTFLAG_DRE_Msk;
+}
+
+static void uart_rx_update(uint64_t t) {
+    if (!uart_rx_enabled()) return;
+    for (int n = 0; n < 64 && t >= uart.rx_next; n++) {
+        int ch = dmac_rx_channel();
+        if (ch < 0 && (uart.intflag & SERCOM_USART_INT_INTFLAG_RXC_Msk)) break;    // DATA unread
+        uint8_t c;
+        if (!in_byte(t, &c)) break;
+        uint64_t frame = uart_frame_ns();
+        if (uart.rx_next + frame < t) uart.rx_next = t;     // the line was idle
+        else uart.rx_next += frame;
+        if (ch >= 0) {
+            dmac[ch].dst[dmac[ch].count % dmac[ch].size] = c;
+            dmac_beat(ch);
+        } else {
+            uart.rx_data = c;
+            uart.intflag |= SERCOM_USART_INT_INTFLAG_RXC_Msk;
+        }
+        if (sercom->SERCOM_CTRLB & SERCOM_USART_INT_CTRLB_SFDE_Msk) uart.intflag |= SERCOM_USART_INT_INTFLAG_RXS_Msk;
+        echo_rx(c, t);
+        stats.rx_bytes++;
+        line_active = t;
+    }
+}
+
+static void sim_update(uint64_t t);
+
+static void sercom_read(uint32_t off) {
+    sim_update(now_ns());
+    if (off == SERCOM_REG(SERCOM_INTFLAG)) {
+        sercom->SERCOM_INTFLAG = uart.intflag;
+    } else if (off == SERCOM_REG(SERCOM_INTENSET) || off == SERCOM_REG(SERCOM_INTENCLR)) {
+        sercom->SERCOM_INTENSET = uart.inten;
+        sercom->SERCOM_INTENCLR = uart.inten;
+    } else if (off == SERCOM_REG(SERCOM_STATUS)) {
+        sercom->SERCOM_STATUS = uart.status;
+    } else if (off == SERCOM_REG(SERCOM_SYNCBUSY)) {
+        *(uint32_t *)&sercom->SERCOM_SYNCBUSY = 0U;   // read-only on the chip
+    } else if (off == SERCOM_REG(SERCOM_DATA)) {
+        sercom->SERCOM_DATA = uart.rx_data;
+        uart.intflag &= (uint8_t)~SERCOM_USART_INT_INTFLAG_RXC_Msk;
+    }
+}
+
+static void sercom_write(uint32_t off) {
+    uint64_t t = now_ns();
+    if (off == SERCOM_REG(SERCOM_INTENSET)) {
+        uart.inten |= sercom->SERCOM_INTENSET;
+    } else if (off == SERCOM_REG(SERCOM_INTENCLR)) {
+        uart.inten &= (uint8_t)~sercom->SERCOM_INTENCLR;
+    } else if (off == SERCOM_REG(SERCOM_INTFLAG)) {     // write one to clear, DRE and RXC can't be
+        uart.intflag &= (uint8_t)~(sercom->SERCOM_INTFLAG & ~(SERCOM_USART_INT_INTFLAG_DRE_Msk | SERCOM_USART_INT_INTFLAG_RXC_Msk));
+    } else if (off == SERCOM_REG(SERCOM_STATUS)) {
+        uart.status &= (uint16_t)~sercom->SERCOM_STATUS;
+    } else if (off == SERCOM_REG(SERCOM_DATA)) {
+        if (uart_tx_enabled()) {
+            uart_tx_update(t);
+            uart_data_write((uint16_t)sercom->SERCOM_DATA, t);
+        }
+    } else if (off == SERCOM_REG(SERCOM_CTRLA)) {
+        if (sercom->SERCOM_CTRLA & SERCOM_USART_INT_CTRLA_SWRST_Msk) {
+            memset(sercom, 0, sizeof(*sercom));
+            memset(&uart, 0, sizeof(uart));
+        }
+    }
+    sim_update(t);
+}
+
+//=================================================================================================
+// TC0, TC2 in 16 and 32-bit counter modes
+//=================================================================================================
+
+typedef struct {
+    uint32_t base;                      // block in sim_io
+    uint32_t hz;                        // counting frequency, after the prescaler
+    bool running;
+    uint64_t start;                     // time the count was at offset
+    uint64_t offset;
+    uint64_t ovf_seen;                  // overflows already flagged since start
+    uint64_t mc_seen[2];                // compare matches already flagged, see tc_matches()
+    uint8_t inten;
+    uint8_t intflag;
+} SIM_TC;
+
+#define TC_REG(field)   offsetof(tc_registers_t, COUNT32.field)
+
+static SIM_TC tc0 = {SIM_TC0};
+static SIM_TC tc2 = {SIM_TC2};
+
+static tc_registers_t *tc_regs(SIM_TC *tc) {
+    return (tc_registers_t *)(regs + tc->base);
+}
+
+static bool tc_is32(SIM_TC *tc) {
+    return (tc_regs(tc)->COUNT32.TC_CTRLA & TC_CTRLA_MODE_Msk) == TC_CTRLA_MODE_COUNT32;
+}
+
+// CC0 is TOP in match frequency/PWM, otherwise a compare value like CC1
+static bool tc_top_cc0(SIM_TC *tc) {
+    uint8_t wavegen = tc_regs(tc)->COUNT32.TC_WAVE & TC_WAVE_WAVEGEN_Msk;
+    return wavegen == TC_WAVE_WAVEGEN_MFRQ || wavegen == TC_WAVE_WAVEGEN_MPWM;
+}
+
+// Counts in a lap: CC0 + 1 in match frequency/PWM, otherwise the full range
+static uint64_t tc_lap(SIM_TC *tc) {
+    tc_registers_t *r = tc_regs(tc);
+    bool top_cc0 = tc_top_cc0(tc);
+    if (tc_is32(tc)) return (top_cc0 ? (uint64_t)r->COUNT32.TC_CC[0] : 0xFFFFFFFFULL) + 1U;
+    return (top_cc0 ? (uint64_t)r->COUNT16.TC_CC[0] : 0xFFFFULL) + 1U;
+}
+
+static uint32_t tc_cc(SIM_TC *tc, int n) {
+    tc_registers_t *r = tc_regs(tc);
+    return tc_is32(tc) ? r->COUNT32.TC_CC[n] : r->COUNT16.TC_CC[n];
+}
+
+static uint32_t tc_cc_offset(SIM_TC *tc, int n) {
+    return tc_is32(tc) ? offsetof(tc_registers_t, COUNT32.TC_CC[n]) : offsetof(tc_registers_t, COUNT16.TC_CC[n]);
+}
+
+// Number of ticks from 0 to ticks at which the count is CCn, none if CCn is past TOP
+static uint64_t tc_matches(SIM_TC *tc, int n, uint64_t ticks) {
+    uint64_t cc = tc_cc(tc, n);
+    uint64_t lap = tc_lap(tc);
+    return (ticks >= cc && cc < lap) ? (ticks - cc) / lap + 1U : 0U;
+}
+
+static uint64_t tc_ticks(SIM_TC *tc, uint64_t t) {
+    return tc->offset + (uint64_t)((unsigned __int128)(t - tc->start) * tc->hz / NS_PER_S);
+}
+
+static uint32_t tc_count(SIM_TC *tc, uint64_t t) {
+    tc_registers_t *r = tc_regs(tc);
+    if (!tc->running) return tc_is32(tc) ? r->COUNT32.TC_COUNT : r->COUNT16.TC_COUNT;
+    return (uint32_t)(tc_ticks(tc, t) % tc_lap(tc));
+}
+
+// Restart counting from count
+static void tc_rebase(SIM_TC *tc, uint64_t t, uint32_t count) {
+    tc->start = t;
+    tc->offset = count;
+    tc->ovf_seen = 0;
+    tc->mc_seen[0] = tc_matches(tc, 0, count);
+    tc->mc_seen[1] = tc_matches(tc, 1, count);
+}
+
+static void tc_store(SIM_TC *tc, uint32_t count) {
+    tc_registers_t *r = tc_regs(tc);
+    if (tc_is32(tc)) r->COUNT32.TC_COUNT = count;
+    else r->COUNT16.TC_COUNT = (uint16_t)count;
+}
+
+static void tc_update(SIM_TC *tc, uint64_t t) {
+    if (!tc->running) return;
+    uint64_t ticks = tc_ticks(tc, t);
+    uint64_t laps = ticks / tc_lap(tc);
+    if (laps > tc->ovf_seen) {
+        tc->ovf_seen = laps;
+        tc->intflag |= TC_INTFLAG_OVF_Msk;
+    }
+    for (int n = 0; n < 2; n++) {
+        uint64_t matches = tc_matches(tc, n, ticks);
+        if (matches > tc->mc_seen[n]) {
+            tc->mc_seen[n] = matches;
+            tc->intflag |= (uint8_t)(TC_INTFLAG_MC0_Msk << n);
+        }
+    }
+}
+
+static uint64_t tc_tick_time(SIM_TC *tc, uint64_t ticks) {
+    return tc->start + (uint64_t)((unsigned __int128)(ticks - tc->offset) * NS_PER_S / tc->hz) + 1U;
+}
+
+// Time of the next enabled overflow or compare match, or UINT64_MAX
+static uint64_t tc_next_event(SIM_TC *tc) {
+    uint64_t next = UINT64_MAX;
+    if (!tc->running || tc->hz == 0U) return next;
+    if (tc->inten & TC_INTENSET_OVF_Msk) {
+        next = tc_tick_time(tc, (tc->ovf_seen + 1U) * tc_lap(tc));
+    }
+    for (int n = 0; n < 2; n++) {
+        if ((tc->inten & (TC_INTENSET_MC0_Msk << n)) && tc_cc(tc, n) < tc_lap(tc)) {
+            uint64_t at = tc_tick_time(tc, tc_cc(tc, n) + tc->mc_seen[n] * tc_lap(tc));
+            if (at < next) next = at;
+        }
+    }
+    return next;
+}
+
+static void tc_read(SIM_TC *tc, uint32_t off) {
+    uint64_t t = now_ns();
+    tc_registers_t *r = tc_regs(tc);
+    sim_update(t);
+    if (off == TC_REG(TC_COUNT)) {
+        tc_store(tc, tc_count(tc, t));
+    } else if (off == TC_REG(TC_INTFLAG)) {
+        r->COUNT32.TC_INTFLAG = tc->intflag;
+    } else if (off == TC_REG(TC_INTENSET) || off == TC_REG(TC_INTENCLR)) {
+        r->COUNT32.TC_INTENSET = tc->inten;
+        r->COUNT32.TC_INTENCLR = tc->inten;
+    } else if (off == TC_REG(TC_SYNCBUSY)) {
+        *(uint32_t *)&r->COUNT32.TC_SYNCBUSY = 0U;
+    } else if (off == TC_REG(TC_CTRLBSET) || off == TC_REG(TC_CTRLBCLR)) {
+        r->COUNT32.TC_CTRLBSET = 0U;    // commands complete at once
+        r->COUNT32.TC_CTRLBCLR = 0U;
+    }
+}
+
+static void tc_write(SIM_TC *tc, uint32_t off) {
+    uint64_t t = now_ns();
+    tc_registers_t *r = tc_regs(tc);
+    if (off == TC_REG(TC_CTRLA)) {
+        uint32_t ctrla = r->COUNT32.TC_CTRLA;
+        if (ctrla & TC_CTRLA_SWRST_Msk) {
+            memset(r, 0, sizeof(*r));
+            tc->running = false;
+            tc->inten = 0;
+            tc->intflag = 0;
+        } else if ((ctrla & TC_CTRLA_ENABLE_Msk) && !tc->running) {
+            tc->running = true;
+            tc_rebase(tc, t, tc_is32(tc) ? r->COUNT32.TC_COUNT : r->COUNT16.TC_COUNT);
+        } else if (!(ctrla & TC_CTRLA_ENABLE_Msk) && tc->running) {
+            tc_store(tc, tc_count(tc, t));
+            tc->running = false;
+        }
+    } else if (off == TC_REG(TC_COUNT)) {
+        tc_rebase(tc, t, tc_is32(tc) ? r->COUNT32.TC_COUNT : r->COUNT16.TC_COUNT);
+    } else if (off == TC_REG(TC_CC[0]) && tc->running && tc_top_cc0(tc)) {
+        tc_rebase(tc, t, tc_count(tc, t));
+    } else if ((off == tc_cc_offset(tc, 0) || off == tc_cc_offset(tc, 1)) && tc->running) {
+        int n = off == tc_cc_offset(tc, 1);
+        tc->mc_seen[n] = tc_matches(tc, n, tc_ticks(tc, t));
+    } else if (off == TC_REG(TC_INTENSET)) {
+        tc->inten |= r->COUNT32.TC_INTENSET;
+    } else if (off == TC_REG(TC_INTENCLR)) {
+        tc->inten &= (uint8_t)~r->COUNT32.TC_INTENCLR;
+    } else if (off == TC_REG(TC_INTFLAG)) {
+        tc->intflag &= (uint8_t)~r->COUNT32.TC_INTFLAG;
+    } else if (off == TC_REG(TC_CTRLBSET)) {
+        uint8_t cmd = r->COUNT32.TC_CTRLBSET & TC_CTRLBSET_CMD_Msk;
+        if (cmd == TC_CTRLBSET_CMD_RETRIGGER) {
+            tc_rebase(tc, t, 0U);
+            tc->running = true;
+            r->COUNT32.TC_CTRLA |= TC_CTRLA_ENABLE_Msk;
+        } else if (cmd == TC_CTRLBSET_CMD_STOP && tc->running) {
+            tc_store(tc, tc_count(tc, t));
+            tc->running = false;
+            r->COUNT32.TC_CTRLA &= ~TC_CTRLA_ENABLE_Msk;
+        }
+        r->COUNT32.TC_CTRLBSET = 0U;
+    }
+    sim_update(t);
+}
+
+static void tc0_read(uint32_t off)  { tc_read(&tc0, off); }
+static void tc0_write(uint32_t off) { tc_write(&tc0, off); }
+static void tc2_read(uint32_t off)  { tc_read(&tc2, off); }
+static void tc2_write(uint32_t off) { tc_write(&tc2, off); }
+
+//=================================================================================================
+// SysTick, DWT and DSU
+//=================================================================================================
+
+static SysTick_Type *systick_regs;
+static SCB_Type *scb_regs;
+static DWT_Type *dwt_regs;
+static dsu_registers_t *dsu_regs;
+
+static struct {
+    bool running;
+    uint64_t start;                     // time of the last enable or VAL write
+    uint64_t first;                     // cycles from start to the first tick, LOAD + 1 at start
+    uint64_t due;                       // ticks since start
+    uint64_t taken;                     // tick interrupts taken since start
+    uint64_t pended;                    // ICSR PENDSTSET, and ticks not taken before a restart or
+                                        // TICKINT clear (each taken, like the ticks above)
+    bool tickint;                       // CTRL TICKINT, ticks while it is clear don't interrupt
+    uint32_t cyccnt_base;               // DWT CYCCNT = cycles since power-on - base
+} core;
+
+static uint64_t systick_period(void) {
+    return (uint64_t)(systick_regs->LOAD & SysTick_LOAD_RELOAD_Msk) + 1U;
+}
+
+static uint64_t systick_cycles(uint64_t t) {
+    return (uint64_t)((unsigned __int128)(t - core.start) * CPU_HZ / NS_PER_S);
+}
+
+// Time of tick n since start (n >= 1): the first after "first" cycles, then every LOAD + 1
+static uint64_t systick_tick_time(uint64_t n) {
+    uint64_t cycles = core.first + (n - 1U) * systick_period();
+    return core.start + (uint64_t)((unsigned __int128)cycles * NS_PER_S / CPU_HZ) + 1U;
+}
+
+static void systick_update(uint64_t t) {
+    if (!core.running) return;
+    uint64_t cycles = systick_cycles(t);
+    core.due = cycles < core.first ? 0U : 1U + (cycles - core.first) / systick_period();
+}
+
+static uint32_t systick_val(uint64_t t) {
+    uint64_t cycles = systick_cycles(t);
+    if (cycles < core.first) return (uint32_t)(core.first - 1U - cycles);
+    return (uint32_t)(systick_period() - 1U - (cycles - core.first) % systick_period());
+}
+
+static void systick_read(uint32_t off) {
+    uint64_t t = now_ns();
+    sim_update(t);
+    if (off == SIM_SYSTICK + offsetof(SysTick_Type, VAL) && core.running) systick_regs->VAL = systick_val(t);
+}
+
+// Enabling, or writing VAL, starts a count down from LOAD; a tick not yet taken stays pending
+static void systick_write(uint32_t off) {
+    uint64_t t = now_ns();
+    bool enable = (systick_regs->CTRL & SysTick_CTRL_ENABLE_Msk) != 0U;
+    if ((off == SIM_SYSTICK + offsetof(SysTick_Type, CTRL) && enable != core.running) ||
+        off == SIM_SYSTICK + offsetof(SysTick_Type, VAL)) {
+        systick_update(t);
+        if (core.tickint) core.pended += core.due - core.taken;
+        if (off == SIM_SYSTICK + offsetof(SysTick_Type, VAL)) systick_regs->VAL = 0U;
+        else if (core.running) systick_regs->VAL = systick_val(t);      // holds the count when stopped
+        core.running = enable;
+        core.start = t;
+        core.first = systick_period();
+        core.due = 0;
+        core.taken = 0;
+    }
+    bool tickint = (systick_regs->CTRL & SysTick_CTRL_TICKINT_Msk) != 0U;
+    if (off == SIM_SYSTICK + offsetof(SysTick_Type, CTRL) && tickint != core.tickint) {
+        systick_update(t);
+        if (tickint) core.taken = core.due;
+        else core.pended += core.due - core.taken;             // already pending, stay so
+        core.tickint = tickint;
+    }
+    sim_update(t);
+}
+
+static bool systick_pending(void) {
+    systick_update(now_ns());
+    return core.pended > 0U || (core.tickint && core.due > core.taken);
+}
+
+static void scb_read(uint32_t off) {
+    if (off == SIM_SCB + offsetof(SCB_Type, ICSR)) scb_regs->ICSR = systick_pending() ? SCB_ICSR_PENDSTSET_Msk : 0U;
+}
+
+// PENDSTSET pends SysTick if it isn't already
+static void scb_write(uint32_t off) {
+    if (off == SIM_SCB + offsetof(SCB_Type, ICSR)) {
+        if ((scb_regs->ICSR & SCB_ICSR_PENDSTSET_Msk) && !systick_pending()) core.pended = 1U;
+        scb_regs->ICSR = 0U;
+    }
+}
+
+static uint32_t cpu_cycles(uint64_t t) {
+    return (uint32_t)((unsigned __int128)t * CPU_HZ / NS_PER_S);
+}
+
+static void dwt_read(uint32_t off) {
+    if (off == SIM_DWT + offsetof(DWT_Type, CYCCNT) && (dwt_regs->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        dwt_regs->CYCCNT = cpu_cycles(now_ns()) - core.cyccnt_base;
+    }
+}
+
+static void dwt_write(uint32_t off) {
+    if (off == SIM_DWT + offsetof(DWT_Type, CYCCNT)) core.cyccnt_base = cpu_cycles(now_ns()) - dwt_regs->CYCCNT;
+}
+
+static void dsu_read(uint32_t off) {
+    if (off == SIM_DSU + offsetof(dsu_registers_t, DSU_DID)) *(uint32_t *)&dsu_regs->DSU_DID = DSU_DID_SAME51J20A;
+}
+
+static void dsu_write(uint32_t off) {
+    if (off == SIM_DSU + offsetof(dsu_registers_t, DSU_CTRL) && (dsu_regs->DSU_CTRL & DSU_CTRL_CRC_Msk)) {
+        dsu_regs->DSU_STATUSA |= DSU_STATUSA_DONE_Msk | DSU_STATUSA_BERR_Msk;  // no bus to read
+    } else if (off == SIM_DSU + offsetof(dsu_registers_t, DSU_STATUSA)) {
+        dsu_regs->DSU_STATUSA = 0U;
+    }
+    dsu_regs->DSU_CTRL = 0U;
+}
+
+//=================================================================================================
+// Register access trapping
+//=================================================================================================
+
+typedef struct {
+    uint32_t base;
+    uint32_t size;
+    void (*read)(uint32_t off);         // before a read, bring the register up to date
+    void (*write)(uint32_t off);        // after a write, act on it
+} SIM_BLOCK;
+
+static void sercom5_read(uint32_t off)  { sercom_read(off + SIM_SERCOM5); }
+static void sercom5_write(uint32_t off) { sercom_write(off + SIM_SERCOM5); }
+static void systick_read_abs(uint32_t off)  { systick_read(off + SIM_SYSTICK); }
+static void systick_write_abs(uint32_t off) { systick_write(off + SIM_SYSTICK); }
+static void dwt_read_abs(uint32_t off)  { dwt_read(off + SIM_DWT); }
+static void dwt_write_abs(uint32_t off) { dwt_write(off + SIM_DWT); }
+static void scb_read_abs(uint32_t off)  { scb_read(off + SIM_SCB); }
+static void scb_write_abs(uint32_t off) { scb_write(off + SIM_SCB); }
+static void dsu_read_abs(uint32_t off)  { dsu_read(off + SIM_DSU); }
+static void dsu_write_abs(uint32_t off) { dsu_write(off + SIM_DSU); }
+
+static const SIM_BLOCK blocks[] = {
+    {SIM_SERCOM5, sizeof(sercom_registers_t), sercom5_read, sercom5_write},
+    {SIM_TC0, sizeof(tc_registers_t), tc0_read, tc0_write},
+    {SIM_TC2, sizeof(tc_registers_t), tc2_read, tc2_write},
+    {SIM_SYSTICK, sizeof(SysTick_Type), systick_read_abs, systick_write_abs},
+    {SIM_SCB, sizeof(SCB_Type), scb_read_abs, scb_write_abs},
+    {SIM_DWT, sizeof(DWT_Type), dwt_read_abs, dwt_write_abs},
+    {SIM_DSU, sizeof(dsu_registers_t), dsu_read_abs, dsu_write_abs},
+};
+
+static struct {
+    uint32_t off;                       // register being single stepped
+    bool write;
+    uint32_t before;                    // its contents before the instruction
+    const SIM_BLOCK *block;
+} trap;
+
+static void sim_interrupts(void);
+
+static void on_segv(int sig, siginfo_t *si, void *context) {
+    ucontext_t *uc = context;
+    uint8_t *addr = si->si_addr;
+    if (addr < sim_io || addr >= sim_io + SIM_IO_SIZE) {
+        signal(SIGSEGV, SIG_DFL);       // a real crash, fault again without the handler
+        return;
+    }
+    trap.off = (uint32_t)(addr - sim_io);
+    trap.write = (uc->uc_mcontext.gregs[REG_ERR] & X86_PF_WRITE) != 0;
+    trap.block = NULL;
+    for (size_t i = 0; i < sizeof(blocks) / sizeof(blocks[0]); i++) {
+        if (trap.off >= blocks[i].base && trap.off < blocks[i].base + blocks[i].size) trap.block = &blocks[i];
+    }
+    if (trap.block && !trap.write) trap.block->read(trap.off - trap.block->base);
+    memcpy(&trap.before, &regs[trap.off], sizeof(trap.before));
+    mprotect(sim_io, SIM_IO_SIZE, PROT_READ | PROT_WRITE);
+    stepping = 1;
+    uc->uc_mcontext.gregs[REG_EFL] |= X86_TRAP_FLAG;
+    stats.accesses++;
+    (void)sig;
+}
+
+static void on_trap(int sig, siginfo_t *si, void *context) {
+    ucontext_t *uc = context;
+    if (!(uc->uc_mcontext.gregs[REG_EFL] & X86_TRAP_FLAG)) return;  // not ours
+    uc->uc_mcontext.gregs[REG_EFL] &= ~(greg_t)X86_TRAP_FLAG;
+    mprotect(sim_io, SIM_IO_SIZE, PROT_NONE);
+    stepping = 0;
+
+    // A read-modify-write may be reported as a read, so compare as well
+    uint32_t after;
+    memcpy(&after, &regs[trap.off], sizeof(after));
+    if (trap.block && (trap.write || after != trap.before)) trap.block->write(trap.off - trap.block->base);
+    sim_interrupts();
+    (void)sig;
+    (void)si;
+}
+
+//=================================================================================================
+// Interrupts
+//=================================================================================================
+
+static bool in_handler;
+static int32_t active_irq;
+
+// Pending interrupt with the lowest number (highest default priority), or false
+static bool irq_pending(IRQn_Type *irq) {
+    if (core.pended > 0U || (core.tickint && core.due > core.taken)) *irq = SysTick_IRQn;
+    else if (dmac[0].complete) *irq = DMAC_0_IRQn;
+    else if (dmac[1].complete) *irq = DMAC_1_IRQn;
+    else if (uart.intflag & uart.inten) *irq = SERCOM5_0_IRQn;
+    else if (tc0.intflag & tc0.inten) *irq = TC0_IRQn;
+    else if (tc2.intflag & tc2.inten) *irq = TC2_IRQn;
+    else return false;
+    return true;
+}
+
+static void dmac_interrupt(int ch) {
+    dmac[ch].complete = false;
+    if (dmac[ch].callback) dmac[ch].callback(DMAC_TRANSFER_EVENT_COMPLETE, dmac[ch].context);
+}
+
+static void sim_update(uint64_t t) {
+    uart_tx_update(t);
+    uart_rx_update(t);
+    tc_update(&tc0, t);
+    tc_update(&tc2, t);
+    systick_update(t);
+    if (out_len && t - out_flushed > FLUSH_NS) out_flush();
+}
+
+// Run the pending handlers, if interrupts are enabled and no handler is running
+static void sim_interrupts(void) {
+    if (sim_primask || in_handler) return;
+    in_handler = true;
+    for (int n = 0; n < 32; n++) {
+        IRQn_Type irq;
+        sim_update(now_ns());
+        if (!irq_pending(&irq)) break;
+        sim_exclusive = 0U;
+        active_irq = irq;
+        stats.interrupts++;
+        switch (irq) {
+            case SysTick_IRQn:
+                if (core.pended > 0U) core.pended--;
+                else core.taken++;
+                SysTick_Handler();
+                break;
+            case DMAC_0_IRQn:       dmac_interrupt(0); break;
+            case DMAC_1_IRQn:       dmac_interrupt(1); break;
+            case SERCOM5_0_IRQn:    SERCOM5_USART_InterruptHandler(); break;
+            case TC0_IRQn:          TC0_TimerInterruptHandler(); break;
+            case TC2_IRQn:          TC2_TimerInterruptHandler(); break;
+            default:                break;
+        }
+    }
+    active_irq = 0;
+    in_handler = false;
+}
+
+// The interval timer: interrupts for code that doesn't touch the registers
+static void on_alarm(int sig) {
+    if (!sim_busy && !stepping) sim_interrupts();
+    (void)sig;
+}
+
+void sim_enable_irq(void) {
+    sim_primask = 0U;
+    sim_busy++;
+    sim_interrupts();
+    sim_busy--;
+}
+
+uint32_t sim_ipsr(void) {
+    return in_handler ? (uint32_t)(active_irq + 16) : 0U;
+}
+
+// Sleep until an interrupt is pending (it runs when PRIMASK is cleared, as on the chip)
+static void wfi(void) {
+    uint64_t t = now_ns();
+    booted = true;
+    IRQn_Type irq;
+    sim_update(t);
+    if (irq_pending(&irq)) return;
+    out_flush();
+
+    bool line_busy = uart.tx_shifting || dmac_tx_channel() >= 0 || in_pos < in_len;
+    if (in_eof && !line_busy && t - line_active > idle_exit_ns) sim_exit();
+
+    // Next thing that can happen by itself
+    uint64_t next = UINT64_MAX;
+    if (core.running && core.tickint) {
+        next = systick_tick_time(core.due + 1U);
+    }
+    if (uart.tx_shifting && uart.tx_shift_end < next) next = uart.tx_shift_end;
+    if (in_pos < in_len && uart.rx_next < next) next = uart.rx_next;
+    if (tc_next_event(&tc0) < next) next = tc_next_event(&tc0);
+    if (tc_next_event(&tc2) < next) next = tc_next_event(&tc2);
+    if (in_eof && line_active + idle_exit_ns < next) next = line_active + idle_exit_ns + 1U;
+
+    struct timespec ts;
+    struct timespec *timeout = NULL;
+    if (next != UINT64_MAX) {
+        uint64_t wait = next > t ? next - t : 0U;
+        ts.tv_sec = (time_t)(wait / NS_PER_S);
+        ts.tv_nsec = (long)(wait % NS_PER_S);
+        timeout = &ts;
+    }
+    bool listen = in_pos == in_len && !in_eof;     // wake early for input
+    if (timeout || listen) {
+        struct pollfd p = {in_fd, POLLIN, 0};
+        sigset_t no_alarm;
+        sigemptyset(&no_alarm);
+        sigaddset(&no_alarm, SIGALRM);
+        if (ppoll(&p, listen ? 1 : 0, timeout, &no_alarm) > 0 && in_pty && !(p.revents & POLLIN)) {
+            usleep(10000);              // hang-up, nobody has the pseudo terminal open
+        }
+        in_next_poll = 0;
+    }
+    stats.sleep_ns += now_ns() - t;
+}
+
+void sim_wfi(void) {
+    sim_busy++;
+    wfi();
+    sim_busy--;
+}
+
+//=================================================================================================
+// Reset and start up
+//=================================================================================================
+
+// Run the simulator again, passing the unread input in the environment
+void sim_reset(void) {
+    static const struct itimerval stop;
+    char hex[2 * sizeof(in_buf) + 1];
+    size_t n = 0;
+    sim_busy++;
+    setitimer(ITIMER_REAL, &stop, NULL);  // survives exec, and SIGALRM would kill the new image
+    out_flush();
+    if (in_tty) tty_restore();          // the new image saves and sets raw mode again
+    for (size_t i = in_pos; i < in_len; i++) n += (size_t)sprintf(&hex[n], "%02X", in_buf[i]);
+    hex[n] = 0;
+    setenv("SIM_INPUT", hex, 1);
+    if (in_eof) setenv("SIM_EOF", "1", 1);
+    if (in_pty) {
+        char fd[16];
+        snprintf(fd, sizeof(fd), "%d", in_fd);
+        setenv("SIM_PTY_FD", fd, 1);
+    }
+    execv("/proc/self/exe", sim_argv);
+    perror("sim: reset");
+    exit(1);
+}
+
+static void restore_input(void) {
+    const char *hex = getenv("SIM_INPUT");
+    for (; hex && hex[0] && hex[1] && in_len < sizeof(in_buf); hex += 2) {
+        unsigned int c;
+        if (sscanf(hex, "%2X", &c) != 1) break;
+        in_buf[in_len++] = (uint8_t)c;
+    }
+    in_eof = getenv("SIM_EOF") != NULL;
+    unsetenv("SIM_INPUT");
+    unsetenv("SIM_EOF");
+}
+
+static void open_pty(void) {
+    const char *fd = getenv("SIM_PTY_FD");
+    if (fd) {
+        in_fd = atoi(fd);
+    } else {
+        in_fd = posix_openpt(O_RDWR | O_NOCTTY);
+        if (in_fd < 0 || grantpt(in_fd) < 0 || unlockpt(in_fd) < 0) {
+            perror("sim: pseudo terminal");
+            exit(1);
+        }
+        struct termios tio;
+        tcgetattr(in_fd, &tio);
+        cfmakeraw(&tio);
+        tcsetattr(in_fd, TCSANOW, &tio);
+        fprintf(stderr, "sim: %s\n", ptsname(in_fd));
+    }
+    out_fd = in_fd;
+    in_pty = true;
+}
+
+// Factory serial number words (cl_id()), at their real addresses
+static void map_serial_number(void) {
+    static const struct { uintptr_t addr; uint32_t value; } words[] = {
+        {0x008061FCU, 0x53494D30U}, {0x00806010U, 0x00000001U}, {0x00806014U, 0x00000002U}, {0x00806018U, 0x00000003U},
+    };
+    void *page = mmap((void *)0x00806000U, 4096, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    if (page == MAP_FAILED) return;
+    for (size_t i = 0; i < sizeof(words) / sizeof(words[0]); i++) *(uint32_t *)words[i].addr = words[i].value;
+}
+
+static void map_registers(void) {
+    int fd = memfd_create("sim_io", 0);
+    if (fd < 0 || ftruncate(fd, SIM_IO_SIZE) < 0) {
+        perror("sim: memfd");
+        exit(1);
+    }
+    sim_io = mmap(NULL, SIM_IO_SIZE, PROT_NONE, MAP_SHARED, fd, 0);
+    regs = mmap(NULL, SIM_IO_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (sim_io == MAP_FAILED || regs == MAP_FAILED) {
+        perror("sim: mmap");
+        exit(1);
+    }
+    close(fd);
+    sercom = &((sercom_registers_t *)(regs + SIM_SERCOM5))->USART_INT;
+    systick_regs = (SysTick_Type *)(regs + SIM_SYSTICK);
+    scb_regs = (SCB_Type *)(regs + SIM_SCB);
+    dwt_regs = (DWT_Type *)(regs + SIM_DWT);
+    dsu_regs = (dsu_registers_t *)(regs + SIM_DSU);
+    *(uint32_t *)&dsu_regs->DSU_DID = DSU_DID_SAME51J20A;
+}
+
+static void trap_registers(void) {
+    struct sigaction sa;
+    sigset_t set;
+    const struct itimerval alarm = {{0, ALARM_US}, {0, ALARM_US}};
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_flags = SA_SIGINFO | SA_NODEFER;  // handlers run from on_trap() access registers too
+    sigaddset(&sa.sa_mask, SIGALRM);
+    sa.sa_sigaction = on_segv;
+    sigaction(SIGSEGV, &sa, NULL);
+    sa.sa_sigaction = on_trap;
+    sigaction(SIGTRAP, &sa, NULL);
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_flags = SA_RESTART;
+    sa.sa_handler = on_alarm;
+    sigaction(SIGALRM, &sa, NULL);
+    sigemptyset(&set);
+    sigaddset(&set, SIGSEGV);
+    sigaddset(&set, SIGTRAP);
+    sigaddset(&set, SIGALRM);
+    sigprocmask(SIG_UNBLOCK, &set, NULL);
+    setitimer(ITIMER_REAL, &alarm, NULL);
+}
+
+// The configurator's SYS_Initialize(), for the simulated peripherals
+void SYS_Initialize(void *data) {
+    (void)data;
+    DMAC_Initialize();
+    TC2_TimerInitialize();
+    SYSTICK_TimerInitialize();
+    SERCOM5_USART_Initialize();
+    TC0_TimerInitialize();
+}
+
+int main(int argc, char **argv) {
+    int opt;
+    while ((opt = getopt(argc, argv, "efpt:v")) != -1) {
+        switch (opt) {
+            case 'e': echo_timing = true; break;
+            case 'f': fast = true; break;
+            case 'p': open_pty(); break;
+            case 't': idle_exit_ns = strtoull(optarg, NULL, 0) * 1000000ULL; break;
+            case 'v': verbose = true; break;
+            default:
+                fprintf(stderr, "usage: %s [-e] [-f] [-p] [-t ms] [-v]\n", argv[0]);
+                return 2;
+        }
+    }
+    sim_argv = argv;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    restore_input();
+
+    if (!in_pty && isatty(in_fd) && tcgetattr(in_fd, &tty_saved) == 0) {
+        struct termios tio = tty_saved;
+        cfmakeraw(&tio);
+        tio.c_oflag |= OPOST | ONLCR;
+        tcsetattr(in_fd, TCSANOW, &tio);
+        atexit(tty_restore);
+        in_tty = true;
+    }
+
+    tc0.hz = TC0_TimerFrequencyGet();
+    tc2.hz = TC2_TimerFrequencyGet();
+    map_registers();
+    map_serial_number();
+    trap_registers();
+    return firmware_main();
+}
@@ -0,0 +1,38 @@
+/**************************************************************************************************
+sim.h
+Host simulation of the SAM E51 peripherals used by the command line firmware
+
+The simulated registers live in one block of host memory, sim_io.  The firmware's *_REGS and core
+peripheral pointers point into it (same51j20a.h and core_cm4.h in this directory override the
+device addresses), and sim.c traps every access to give the registers their hardware behaviour.
+
+**************************************************************************************************/
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+
+// Register blocks in sim_io, each at least as big as its DFP register struct
+#define SIM_SERCOM5     0x0000U
+#define SIM_TC0         0x0100U
+#define SIM_TC2         0x0200U
+#define SIM_PAC         0x0300U
+#define SIM_PORT        0x0400U
+#define SIM_SYSTICK     0x0800U
+#define SIM_DWT         0x0900U
+#define SIM_COREDEBUG   0x0A00U
+#define SIM_SCB         0x0B00U
+#define SIM_DSU         0x1000U
+#define SIM_IO_SIZE     0x4000U
+
+extern uint8_t *sim_io;
+extern volatile uint32_t sim_primask;   // PRIMASK, 1 = interrupts disabled
+extern volatile uint32_t sim_exclusive; // exclusive monitor, cleared when a handler runs
+
+void sim_enable_irq(void);
+void sim_wfi(void);
+uint32_t sim_ipsr(void);
+void sim_reset(void) __attribute__((noreturn));
+
+#endif // SIM_H